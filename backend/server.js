@@ -43,15 +43,65 @@ const trimEmptyEdges = (lines) => {
   return lines.slice(start, end + 1);
 };
 
+const RECORD_PREFIX = "#RECORD ";
+const QUESTION_MARKERS = ["#JUDGE", "#CHOICE", "#MULTICHOICE", "#SUBJECTIVE"];
+
+// obj-insert and sub-insert save every edit as "#RECORD <id> PUT <bytes>" or
+// "#RECORD <id> DEL" lines; keep the newest live text of each id, in id order.
+const liveQuestionLines = (lines) => {
+  const slots = [];
+  let pending = null;
+  let index = 0;
+
+  while (index < lines.length) {
+    const line = lines[index].trim();
+    if (line.startsWith(RECORD_PREFIX)) {
+      const parts = line.split(/\s+/);
+      pending = null;
+      if (parts.length >= 3 && /^\d+$/.test(parts[1])) {
+        const recordId = Number.parseInt(parts[1], 10);
+        if (parts[2] === "PUT") {
+          pending = recordId;
+        } else if (parts[2] === "DEL" && recordId < slots.length) {
+          slots[recordId] = null;
+        }
+      }
+      index += 1;
+      continue;
+    }
+    if (QUESTION_MARKERS.includes(line)) {
+      let end = index + 1;
+      while (end < lines.length) {
+        const current = lines[end].trim();
+        if (current === "#END") {
+          end += 1;
+          break;
+        }
+        if (QUESTION_MARKERS.includes(current) || current.startsWith(RECORD_PREFIX)) break;
+        end += 1;
+      }
+      const recordId = pending === null ? slots.length : pending;
+      while (slots.length <= recordId) slots.push(null);
+      slots[recordId] = lines.slice(index, end);
+      pending = null;
+      index = end;
+      continue;
+    }
+    index += 1;
+  }
+
+  return slots.filter(Boolean).flat();
+};
+
 const parseObjectiveFromText = (content, source) => {
-  const lines = content.split(/\r?\n/);
+  const lines = liveQuestionLines(content.split(/\r?\n/));
   const questions = [];
   let index = 0;
 
   while (index < lines.length) {
     const marker = lines[index].trim();
-    if (marker === "#JUDGE" || marker === "#CHOICE") {
-      const qtype = marker === "#JUDGE" ? "judge" : "single";
+    if (marker === "#JUDGE" || marker === "#CHOICE" || marker === "#MULTICHOICE") {
+      const qtype = { "#JUDGE": "judge", "#CHOICE": "single", "#MULTICHOICE": "multiple" }[marker];
       index += 1;
       const questionLines = [];
       while (index < lines.length && lines[index].trim() !== "#OPTIONS") {
@@ -74,18 +124,31 @@ const parseObjectiveFromText = (content, source) => {
           answerIndex = parsed - 1;
         }
       }
+      const answerIndices = [
+        ...new Set(
+          answerLine
+            .split(/[\s,]+/)
+            .map((item) => Number.parseInt(item, 10) - 1)
+            .filter((item) => item >= 0 && item < 32)
+        ),
+      ].sort((a, b) => a - b);
       while (index < lines.length && lines[index].trim() !== "#END") {
         index += 1;
       }
       index += 1;
-      questions.push({
+      const question = {
         id: randomUUID(),
         qtype,
         question: trimEmptyEdges(questionLines).join("\n"),
         options,
         answer_index: Math.max(answerIndex, 0),
-        source,
-      });
+      };
+      if (qtype === "multiple") {
+        question.answer_index = answerIndices.length > 0 ? answerIndices[0] : 0;
+        question.answer_indices = answerIndices;
+      }
+      question.source = source;
+      questions.push(question);
       continue;
     }
     index += 1;
@@ -95,7 +158,7 @@ const parseObjectiveFromText = (content, source) => {
 };
 
 const parseSubjectiveFromText = (content, source) => {
-  const lines = content.split(/\r?\n/);
+  const lines = liveQuestionLines(content.split(/\r?\n/));
   const questions = [];
   let index = 0;
 
@@ -162,19 +225,36 @@ const normalizeCount = (value, fallback = 1) => {
   return parsed;
 };
 
-const validateObjectivePayload = ({ question, options, answer_index: answerIndex, qtype }) => {
+const validateObjectivePayload = ({
+  question,
+  options,
+  answer_index: answerIndex,
+  answer_indices: answerIndices,
+  qtype,
+}) => {
   if (typeof question !== "string" || question.trim().length === 0) {
     return "question 不能为空";
   }
   if (!Array.isArray(options) || options.length < 2 || options.some((item) => typeof item !== "string")) {
     return "options 至少包含两个选项";
   }
+  if (qtype && !["single", "judge", "multiple"].includes(qtype)) {
+    return "qtype 只能是 single、judge 或 multiple";
+  }
+  if (qtype === "multiple") {
+    if (
+      !Array.isArray(answerIndices) ||
+      answerIndices.length === 0 ||
+      answerIndices.some((index) => !Number.isInteger(index) || index < 0 || index >= options.length) ||
+      new Set(answerIndices).size !== answerIndices.length
+    ) {
+      return "answer_indices 必须是不重复且不超出范围的选项序号";
+    }
+    return null;
+  }
   if (!Number.isInteger(answerIndex) || answerIndex < 0 || answerIndex >= options.length) {
     return "answer_index 超出范围";
   }
-  if (qtype && !["single", "judge"].includes(qtype)) {
-    return "qtype 只能是 single 或 judge";
-  }
   return null;
 };
 
@@ -240,6 +320,11 @@ app.post("/api/questions/objective", async (req, res, next) => {
       qtype: payload.qtype || "single",
       source: payload.source || null,
     };
+    if (question.qtype === "multiple") {
+      const answerIndices = [...payload.answer_indices].sort((a, b) => a - b);
+      question.answer_index = answerIndices[0];
+      question.answer_indices = answerIndices;
+    }
 
     const questions = await readJsonFile(OBJECTIVE_PATH);
     questions.push(question);
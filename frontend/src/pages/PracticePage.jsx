@@ -10,12 +10,15 @@ const getOptionLabel = (index) => OPTION_LABELS[index] || `#${index + 1}`;
 const normalizeSource = (source) => source || "未分类";
 const getSourceLabel = (source) =>
   source ? source.replace(/\.txt$/i, "") : "未分类";
+const isMultiple = (question) => question?.qtype === "multiple";
+const getAnswerIndices = (question) =>
+  Array.isArray(question.answer_indices) ? question.answer_indices : [question.answer_index];
 
 const PracticePage = () => {
   const [objectiveSet, setObjectiveSet] = useState("");
   const [objectiveBank, setObjectiveBank] = useState([]);
   const [objectiveError, setObjectiveError] = useState("");
-  const [selectedIndex, setSelectedIndex] = useState(null);
+  const [selectedIndices, setSelectedIndices] = useState([]);
   const [objectiveResult, setObjectiveResult] = useState(null);
   const [questionIndex, setQuestionIndex] = useState(0);
 
@@ -67,7 +70,7 @@ const PracticePage = () => {
   const pageQuestions = objectiveQuestions.slice(pageStartIndex, pageStartIndex + PAGE_SIZE);
 
   const resetObjectiveAnswer = () => {
-    setSelectedIndex(null);
+    setSelectedIndices([]);
     setObjectiveResult(null);
   };
 
@@ -94,13 +97,26 @@ const PracticePage = () => {
     selectQuestion(questionIndex + 1);
   };
 
+  const toggleOption = (index) => {
+    if (!isMultiple(objectiveQuestion)) {
+      setSelectedIndices([index]);
+      return;
+    }
+    setSelectedIndices((current) =>
+      current.includes(index) ? current.filter((item) => item !== index) : [...current, index]
+    );
+  };
+
   const checkAnswer = () => {
     if (!objectiveQuestion) return;
-    if (selectedIndex === null) {
+    if (selectedIndices.length === 0) {
       setObjectiveResult({ message: "请选择一个答案。", success: false });
       return;
     }
-    const isCorrect = selectedIndex === objectiveQuestion.answer_index;
+    const answerIndices = getAnswerIndices(objectiveQuestion);
+    const isCorrect =
+      selectedIndices.length === answerIndices.length &&
+      answerIndices.every((index) => selectedIndices.includes(index));
     setObjectiveResult({
       message: isCorrect ? "回答正确！" : "回答错误。",
       success: isCorrect,
@@ -208,15 +224,16 @@ const PracticePage = () => {
                 </div>
               </div>
               <h3 className="question-text">{objectiveQuestion.question}</h3>
+              {isMultiple(objectiveQuestion) && <p className="form-status">多选题，请选出全部正确选项。</p>}
               <div className="options">
                 {objectiveQuestion.options.map((option, index) => (
                   <label className="option" key={`${option}-${index}`}>
                     <input
-                      type="radio"
+                      type={isMultiple(objectiveQuestion) ? "checkbox" : "radio"}
                       name="practice-option"
                       value={index}
-                      checked={selectedIndex === index}
-                      onChange={() => setSelectedIndex(index)}
+                      checked={selectedIndices.includes(index)}
+                      onChange={() => toggleOption(index)}
                     />
                     <span className="option-label">{getOptionLabel(index)}.</span>
                     <span className="option-text">{option}</span>
@@ -17,6 +17,49 @@ def read_lines(path: Path) -> list[str]:
         return path.read_text(encoding="gbk", errors="replace").splitlines()
 
 
+RECORD_PREFIX = "#RECORD "
+QUESTION_MARKERS = {"#JUDGE", "#CHOICE", "#MULTICHOICE", "#SUBJECTIVE"}
+
+
+def live_question_lines(lines: list[str]) -> list[str]:
+    """Drop deleted and superseded questions from a bank edited with obj-insert/sub-insert."""
+    slots: list[list[str] | None] = []
+    pending: int | None = None
+    index = 0
+    while index < len(lines):
+        line = lines[index].strip()
+        if line.startswith(RECORD_PREFIX):
+            parts = line.split()
+            pending = None
+            if len(parts) >= 3 and parts[1].isdigit():
+                record_id = int(parts[1])
+                if parts[2] == "PUT":
+                    pending = record_id
+                elif parts[2] == "DEL" and record_id < len(slots):
+                    slots[record_id] = None
+            index += 1
+            continue
+        if line in QUESTION_MARKERS:
+            end = index + 1
+            while end < len(lines):
+                current = lines[end].strip()
+                if current == "#END":
+                    end += 1
+                    break
+                if current in QUESTION_MARKERS or current.startswith(RECORD_PREFIX):
+                    break
+                end += 1
+            record_id = len(slots) if pending is None else pending
+            if record_id >= len(slots):
+                slots.extend([None] * (record_id + 1 - len(slots)))
+            slots[record_id] = lines[index:end]
+            pending = None
+            index = end
+            continue
+        index += 1
+    return [line for block in slots if block for line in block]
+
+
 def trim_empty_edges(lines: list[str]) -> list[str]:
     start = 0
     end = len(lines) - 1
@@ -28,7 +71,7 @@ def trim_empty_edges(lines: list[str]) -> list[str]:
 
 
 def parse_objective_file(path: Path) -> list[dict]:
-    lines = read_lines(path)
+    lines = live_question_lines(read_lines(path))
     questions: list[dict] = []
     index = 0
 
@@ -70,7 +113,7 @@ def parse_objective_file(path: Path) -> list[dict]:
 
 
 def parse_subjective_file(path: Path) -> list[dict]:
-    lines = read_lines(path)
+    lines = live_question_lines(read_lines(path))
     questions: list[dict] = []
     index = 0
 
@@ -0,0 +1,497 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <cmath>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "../Common/answer-journal.h"
+#include "../Common/answer-mask.h"
+#include "../Common/compiled-bank.h"
+#include "../Common/dedup-index.h"
+#include "../Common/item-response.h"
+#include "../Common/json.h"
+#include "../Common/question-sampler.h"
+
+using namespace std;
+
+// ׼׼ɺϳ⣬зֺʱⱾдѶУ׼ʱͷֵڴ棬
+// дɱƽ JSONÿһͬ汾Ľֱ diff  --compare Աȡ
+// ͬĲɵֽͬ
+// ÷bench-suite [-q ] [--code-ratio ] [--mix ж,ѡ,ѡ,] [--seed ]
+//                   [-r ظ] [--label ǩ] [--out .json] [--keep]
+//       bench-suite --generate .txt [-q ] [--code-ratio ] [--mix ...] [--seed ]
+//       bench-suite --compare ɽ.json ½.json
+
+struct GeneratorOptions {
+    size_t questions = 20000;
+    double codeRatio = 0.2;         // ɴĿ
+    size_t mix[4] = {1, 4, 3, 2};   // JUDGE/CHOICE/MULTICHOICE/SUBJECTIVE Ȩ
+    uint64_t seed = 1;
+};
+
+const char* const kWords[] = {
+    "߳", "", "ӿ", "̳", "̬", "쳣", "", "", "", "", "ڴ", "ҳ",
+    "", "ź", "ļ", "Ŀ¼", "Э", "·", "˿", "", "", "", "ȷ", "",
+    "", "", "", "", "", "ַ", "class", "static", "final", "TCP", "UDP", "I/O",
+    "HashMap", "ArrayList", "synchronized", "()", "", "",
+};
+const char* const kCode[] = {
+    "public class Main {", "int[] a = new int[10];", "for (int i = 0; i < n; i++) {", "sum += a[i];",
+    "System.out.println(sum);", "List<String> list = new ArrayList<>();", "if (x > 0) return x;",
+    "try { s.close(); } catch (IOException e) { }", "}", "Thread t = new Thread(r);", "t.start();",
+};
+
+string pick(const char* const* items, size_t count, QuizRandom& rng) {
+    return items[rng.below(count)];
+}
+
+void appendSentence(string& out, size_t words, QuizRandom& rng) {
+    for (size_t i = 0; i < words; ++i) out += pick(kWords, size(kWords), rng);
+    out += "\n";
+}
+
+// һ⣬ʽ obj-insert / sub-insert дͬ
+void appendQuestion(string& out, int type, const GeneratorOptions& opt, QuizRandom& rng) {
+    static const char* const kTypes[] = {"#JUDGE\n", "#CHOICE\n", "#MULTICHOICE\n", "#SUBJECTIVE\n"};
+    out += kTypes[type];
+    size_t stemLines = 1 + rng.below(2);
+    for (size_t i = 0; i < stemLines; ++i) appendSentence(out, 6 + rng.below(18), rng);
+    if (rng.below(1000000) < opt.codeRatio * 1000000) {
+        size_t codeLines = 3 + rng.below(10);
+        for (size_t i = 0; i < codeLines; ++i) {
+            out += "    ";
+            out += pick(kCode, size(kCode), rng);
+            out += "\n";
+        }
+    }
+
+    if (type == 3) {
+        out += "#ANSWER\n";
+        size_t points = 1 + rng.below(4);
+        for (size_t i = 0; i < points; ++i) appendSentence(out, 2 + rng.below(8), rng);
+        out += "#END\n\n";
+        return;
+    }
+
+    size_t options = type == 0 ? 2 : 4 + rng.below(3);
+    out += "#OPTIONS\n";
+    for (size_t i = 0; i < options; ++i) {
+        if (type == 0) out += i == 0 ? "T\n" : "F\n";
+        else appendSentence(out, 2 + rng.below(6), rng);
+    }
+    out += "#CORRECT\n";
+    if (type == 2) {
+        vector<uint32_t> correct = sampleIndices(options, 2 + rng.below(2), rng);
+        sort(correct.begin(), correct.end());
+        for (size_t i = 0; i < correct.size(); ++i) {
+            if (i > 0) out += ",";
+            out += to_string(correct[i] + 1);
+        }
+        out += "\n";
+    } else {
+        out += to_string(rng.below(options) + 1) + "\n";
+    }
+    out += "#END\n\n";
+}
+
+string generateBank(const GeneratorOptions& opt) {
+    QuizRandom rng(opt.seed);
+    size_t totalWeight = opt.mix[0] + opt.mix[1] + opt.mix[2] + opt.mix[3];
+    string out;
+    for (size_t i = 0; i < opt.questions && totalWeight > 0; ++i) {
+        size_t r = rng.below(totalWeight);
+        int type = 0;
+        while (r >= opt.mix[type]) r -= opt.mix[type++];
+        appendQuestion(out, type, opt, rng);
+    }
+    return out;
+}
+
+// ֵפڴ棨KBWindows ϲͳƣ 0
+size_t peakRssKb() {
+#ifdef _WIN32
+    return 0;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// ظ runs ȡһΣ룩
+template <typename F>
+double bestMs(int runs, F&& fn) {
+    double best = 1e300;
+    for (int i = 0; i < runs; ++i) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+//  obj-quiz  writeAnswerToFile ͬı¼
+void appendTextRecord(string& record, const Question& q, uint32_t userAnswers) {
+    auto appendMask = [&](uint32_t mask) {
+        bool first = true;
+        for (; mask; mask &= mask - 1) {
+            size_t idx = lowestBit(mask);
+            if (idx >= q.options.size()) continue;
+            if (!first) record += ",";
+            record += q.options[idx];
+            first = false;
+        }
+    };
+    record += "#";
+    record += questionTypeName(q.type);
+    record += "\n";
+    for (const auto& line : q.question) {
+        record += line;
+        record += "\n";
+    }
+    record += "#OPTIONS\n";
+    for (size_t j = 0; j < q.options.size(); ++j) {
+        if (questionTypeInfo(q.type).numberedOptions) record += to_string(j + 1);
+        else record += static_cast<char>('A' + j);
+        record += ". ";
+        record += q.options[j];
+        record += "\n";
+    }
+    record += "#USER_ANSWER\n";
+    appendMask(userAnswers);
+    record += "\n#CORRECT_ANSWER\n";
+    appendMask(q.correctAnswers);
+    record += "\n#END\n\n";
+}
+
+// ׼̬Box-Muller
+double normalSample(QuizRandom& rng) {
+    double u1 = ((rng() >> 11) + 1) * 0x1.0p-53, u2 = (rng() >> 11) * 0x1.0p-53;
+    return sqrt(-2 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+double correlation(const vector<double>& x, const vector<double>& y) {
+    double mx = 0, my = 0;
+    for (size_t i = 0; i < x.size(); ++i) mx += x[i], my += y[i];
+    mx /= x.size();
+    my /= y.size();
+    double sxy = 0, sxx = 0, syy = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxy += (x[i] - mx) * (y[i] - my);
+        sxx += (x[i] - mx) * (x[i] - mx);
+        syy += (y[i] - my) * (y[i] - my);
+    }
+    return sxx > 0 && syy > 0 ? sxy / sqrt(sxx * syy) : 0;
+}
+
+// ̶˳¼дʱÿһ
+struct Results {
+    vector<pair<string, string>> items;
+
+    void add(const string& key, double value, int decimals) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+        items.push_back({key, buf});
+    }
+    void addText(const string& key, const string& value) {
+        string quoted;
+        appendJsonString(quoted, value);
+        items.push_back({key, quoted});
+    }
+
+    string toJsonText() const {
+        string out = "{\n";
+        for (size_t i = 0; i < items.size(); ++i) {
+            out += "  ";
+            appendJsonString(out, items[i].first);
+            out += ": " + items[i].second + (i + 1 < items.size() ? ",\n" : "\n");
+        }
+        return out + "}\n";
+    }
+};
+
+int runSuite(const GeneratorOptions& opt, int runs, const string& label, const string& outFile, bool keep) {
+    const string bankFile = "bench-bank.txt";
+    const string textJournal = "bench-journal.txt";
+    const string binaryJournal = "bench-journal.qjl";
+
+    Results r;
+    r.addText("label", label);
+    r.addText("compiler", __VERSION__);
+    r.add("questions", double(opt.questions), 0);
+    r.add("code_ratio", opt.codeRatio, 3);
+    r.add("seed", double(opt.seed), 0);
+
+    string text = generateBank(opt);
+    {
+        ofstream out(bankFile, ios::binary);
+        out << text;
+        if (!out) {
+            cerr << "Unable to write " << bankFile << "\n";
+            return 1;
+        }
+    }
+    r.add("bank_bytes", double(text.size()), 0);
+    text.clear();
+    text.shrink_to_fit();
+
+    //  obj-quiz / sub-quiz  .txt ķʽͬ
+    QuestionBank bank;
+    if (!loadQuestions(bankFile, bank)) return 1;
+    size_t parsed = bank.questions.size();
+    double parseMs = bestMs(runs, [&] {
+        QuestionBank b;
+        loadQuestions(bankFile, b);
+        parsed = b.questions.size();
+    });
+    double mb = bank.file.size() / 1048576.0;
+    r.add("parsed_questions", double(parsed), 0);
+    r.add("parse_ms", parseMs, 3);
+    r.add("parse_mb_per_s", mb / parseMs * 1000, 1);
+    r.add("parse_questions_per_s", parsed / parseMs * 1000, 0);
+
+    // з֣ÿ͹һ루ĸֻã parseUserAnswer з
+    vector<const Question*> objective;
+    for (const auto& q : bank.questions) {
+        if (isObjective(q.type) && !q.options.empty()) objective.push_back(&q);
+    }
+    QuizRandom rng(opt.seed);
+    vector<string> inputs(objective.size());
+    vector<vector<int>> orders(objective.size());
+    vector<uint32_t> userMasks(objective.size());
+    for (size_t i = 0; i < objective.size(); ++i) {
+        const Question& q = *objective[i];
+        orders[i].resize(q.options.size());
+        for (size_t j = 0; j < orders[i].size(); ++j) orders[i][j] = static_cast<int>(j);
+        shuffleInPlace(orders[i], rng);
+        size_t picks = questionTypeInfo(q.type).multipleAnswers ? 1 + rng.below(3) : 1;
+        for (uint32_t idx : sampleIndices(q.options.size(), picks, rng)) {
+            if (!inputs[i].empty()) inputs[i] += rng.below(2) ? ", " : ",";
+            if (q.type == QuestionType::JUDGE) inputs[i] += idx == 0 ? "T" : "F";
+            else inputs[i] += rng.below(2) ? string(1, char('A' + idx)) : to_string(idx + 1);
+        }
+    }
+    size_t correct = 0;
+    const int gradeRounds = 20;
+    double gradeMs = bestMs(runs, [&] {
+        correct = 0;
+        for (int round = 0; round < gradeRounds; ++round) {
+            for (size_t i = 0; i < objective.size(); ++i) {
+                userMasks[i] = parseUserAnswer(inputs[i], orders[i], objective[i]->type);
+                correct += userMasks[i] == objective[i]->correctAnswers;
+            }
+        }
+    });
+    size_t graded = objective.size() * gradeRounds;
+    r.add("graded_answers", double(objective.size()), 0);
+    r.add("graded_correct", double(correct / gradeRounds), 0);
+    r.add("grade_ns_per_op", graded ? gradeMs * 1e6 / graded : 0, 2);
+
+    // ͬ밴ͷз֣ÿѭֻʵһ͵Ľ
+    TypePartitions parts;
+    for (size_t i = 0; i < objective.size(); ++i) {
+        parts[static_cast<size_t>(objective[i]->type)].push_back(static_cast<uint32_t>(i));
+    }
+    size_t partitionedCorrect = 0;
+    double partitionedMs = bestMs(runs, [&] {
+        partitionedCorrect = 0;
+        for (int round = 0; round < gradeRounds; ++round) {
+            forEachPartition(parts, [&](auto tag, const vector<uint32_t>& indices) {
+                for (uint32_t i : indices) {
+                    userMasks[i] = parseUserAnswerAs<decltype(tag)::value>(inputs[i], orders[i]);
+                    partitionedCorrect += userMasks[i] == objective[i]->correctAnswers;
+                }
+            });
+        }
+    });
+    if (partitionedCorrect != correct) cerr << "partitioned grading disagrees with per-question grading\n";
+    r.add("grade_partitioned_ns_per_op", graded ? partitionedMs * 1e6 / graded : 0, 2);
+
+    // Ȿÿ͹дһ¼ʱرʱ fsync
+    size_t textBytes = 0;
+    double textMs = bestMs(runs, [&] {
+        remove(textJournal.c_str());
+        AnswerJournal journal;
+        journal.open(textJournal);
+        string record;
+        textBytes = 0;
+        for (size_t i = 0; i < objective.size(); ++i) {
+            record.clear();
+            appendTextRecord(record, *objective[i], userMasks[i]);
+            textBytes += record.size();
+            journal.append(record);
+        }
+        journal.close();
+    });
+    r.add("journal_text_records_per_s", objective.size() / textMs * 1000, 0);
+    r.add("journal_text_mb_per_s", textBytes / 1048576.0 / textMs * 1000, 1);
+
+    vector<uint64_t> fingerprints(objective.size());
+    for (size_t i = 0; i < objective.size(); ++i) fingerprints[i] = questionFingerprint(*objective[i]);
+    double binaryMs = bestMs(runs, [&] {
+        remove(binaryJournal.c_str());
+        AnswerJournal journal;
+        journal.open(binaryJournal);
+        for (size_t i = 0; i < objective.size(); ++i) {
+            const Question& q = *objective[i];
+            JournalEntry entry{};
+            entry.fingerprint = fingerprints[i];
+            entry.time = static_cast<int64_t>(i);
+            entry.userAnswers = userMasks[i];
+            entry.correctAnswers = q.correctAnswers;
+            entry.type = static_cast<uint8_t>(q.type);
+            entry.correct = userMasks[i] == q.correctAnswers;
+            journal.append(entry);
+        }
+        journal.close();
+    });
+    double binaryBytes = double(filesystem::file_size(binaryJournal));
+    r.add("journal_binary_records_per_s", objective.size() / binaryMs * 1000, 0);
+    r.add("journal_binary_mb_per_s", binaryBytes / 1048576.0 / binaryMs * 1000, 1);
+
+    // ѶУ׼֪Ŀ2PLģ 1000 ѧ 1000 Σ-q 20000 ʱÿƽԼ 60 Σ
+    // ¼ EM У׼ĺʱԼƵѶȡʵֵϵ
+    const size_t learners = 1000, perLearner = 1000;
+    size_t items = max<size_t>(objective.size(), 1);
+    vector<ItemParameters> truth(items);
+    for (auto& p : truth) p = {0.5 + 1.5 * (rng() >> 11) * 0x1.0p-53, normalSample(rng)};
+    vector<double> trueAbility(learners);
+    for (auto& t : trueAbility) t = normalSample(rng);
+    vector<Attempt> attempts;
+    attempts.reserve(learners * perLearner);
+    for (size_t l = 0; l < learners; ++l) {
+        for (size_t k = 0; k < perLearner; ++k) {
+            uint32_t j = static_cast<uint32_t>(rng.below(items));
+            double p = AbilityTracker::probability(truth[j], trueAbility[l]);
+            attempts.push_back({static_cast<uint32_t>(l), j, (rng() >> 11) * 0x1.0p-53 < p});
+        }
+    }
+    Calibration calibration;
+    double calibrateMs = bestMs(1, [&] { calibration = calibrate(buildResponseMatrix(learners, items, attempts)); });
+    vector<double> trueB(items), estimatedB(items);
+    for (size_t j = 0; j < items; ++j) {
+        trueB[j] = truth[j].b;
+        estimatedB[j] = calibration.items[j].b;
+    }
+    r.add("calibrate_attempts", double(attempts.size()), 0);
+    r.add("calibrate_iterations", double(calibration.iterations), 0);
+    r.add("calibrate_ms", calibrateMs, 1);
+    r.add("calibrate_difficulty_r", correlation(trueB, estimatedB), 3);
+    r.add("calibrate_ability_r", correlation(trueAbility, calibration.ability), 3);
+
+    r.add("peak_rss_kb", double(peakRssKb()), 0);
+
+    if (!keep) {
+        remove(bankFile.c_str());
+        remove(storeIndexPath(bankFile).c_str());
+        remove(textJournal.c_str());
+        remove(binaryJournal.c_str());
+    }
+
+    string json = r.toJsonText();
+    cout << json;
+    if (!outFile.empty()) {
+        ofstream out(outFile, ios::binary);
+        out << json;
+        if (!out) {
+            cerr << "Unable to write " << outFile << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+bool readResults(const string& filename, JsonValue& v) {
+    ifstream in(filename, ios::binary);
+    stringstream ss;
+    ss << in.rdbuf();
+    if (!in || !parseJson(ss.str(), v) || !v.isObject()) {
+        cerr << "Unable to read results: " << filename << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Աνֵ仯ٷֱ
+int compareResults(const string& oldFile, const string& newFile) {
+    JsonValue before, after;
+    if (!readResults(oldFile, before) || !readResults(newFile, after)) return 1;
+    printf("%-30s %16s %16s %9s\n", "metric", "old", "new", "change");
+    for (const auto& m : after.members) {
+        const JsonValue* old = before.find(m.first);
+        if (m.second.type != JsonValue::NUMBER) {
+            string o = old && old->isString() ? old->str : "-";
+            if (o != m.second.str) printf("%-30s %16s %16s\n", m.first.c_str(), o.c_str(), m.second.str.c_str());
+            continue;
+        }
+        if (!old || old->type != JsonValue::NUMBER) {
+            printf("%-30s %16s %16.3f\n", m.first.c_str(), "-", m.second.number);
+            continue;
+        }
+        printf("%-30s %16.3f %16.3f", m.first.c_str(), old->number, m.second.number);
+        if (old->number != 0) printf(" %+8.1f%%", (m.second.number - old->number) * 100.0 / old->number);
+        printf("\n");
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions opt;
+    string generateFile, outFile, label;
+    vector<string> compareFiles;
+    int runs = 5;
+    bool keep = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-q" && i + 1 < argc) opt.questions = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--code-ratio" && i + 1 < argc) opt.codeRatio = atof(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc) opt.seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-r" && i + 1 < argc) runs = max(1, atoi(argv[++i]));
+        else if (arg == "--label" && i + 1 < argc) label = argv[++i];
+        else if (arg == "--out" && i + 1 < argc) outFile = argv[++i];
+        else if (arg == "--generate" && i + 1 < argc) generateFile = argv[++i];
+        else if (arg == "--keep") keep = true;
+        else if (arg == "--compare" && i + 2 < argc) {
+            compareFiles = {argv[i + 1], argv[i + 2]};
+            i += 2;
+        } else if (arg == "--mix" && i + 1 < argc) {
+            if (sscanf(argv[++i], "%zu,%zu,%zu,%zu", &opt.mix[0], &opt.mix[1], &opt.mix[2], &opt.mix[3]) != 4) {
+                cerr << "--mix expects four weights: judge,choice,multichoice,subjective\n";
+                return 1;
+            }
+        } else {
+            cerr << "usage: bench-suite [-q questions] [--code-ratio r] [--mix j,c,m,s] [--seed n] [-r runs]\n"
+                    "                   [--label text] [--out results.json] [--keep]\n"
+                    "       bench-suite --generate bank.txt [-q questions] [--code-ratio r] [--mix j,c,m,s] [--seed n]\n"
+                    "       bench-suite --compare old.json new.json\n";
+            return 1;
+        }
+    }
+
+    if (!compareFiles.empty()) return compareResults(compareFiles[0], compareFiles[1]);
+    if (!generateFile.empty()) {
+        string text = generateBank(opt);
+        ofstream out(generateFile, ios::binary);
+        out << text;
+        if (!out) {
+            cerr << "Unable to write " << generateFile << "\n";
+            return 1;
+        }
+        cout << "Wrote " << opt.questions << " questions (" << text.size() << " bytes) to " << generateFile << "\n";
+        return 0;
+    }
+    return runSuite(opt, runs, label, outFile, keep);
+}
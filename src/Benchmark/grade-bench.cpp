@@ -0,0 +1,90 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cctype>
+
+#include "../Common/answer-mask.h"
+
+using namespace std;
+
+// ɰзַʽsubstr/erase  vector<int>ƺٱȽϣڶԱ
+vector<int> legacyParse(const string& input, const vector<int>& optionIndices) {
+    vector<int> answers;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        while (pos < input.size() && isspace(input[pos])) pos++;
+        if (pos >= input.size()) break;
+        size_t comma = input.find(',', pos);
+        string token;
+        if (comma == string::npos) {
+            token = input.substr(pos);
+            pos = input.size();
+        } else {
+            token = input.substr(pos, comma - pos);
+            pos = comma + 1;
+        }
+        token.erase(remove_if(token.begin(), token.end(), ::isspace), token.end());
+        if (token.empty()) continue;
+        int idx = isdigit(token[0]) ? stoi(token) - 1 : charToIndex(token[0]);
+        if (idx >= 0 && idx < (int)optionIndices.size()) answers.push_back(optionIndices[idx]);
+    }
+    return answers;
+}
+
+bool legacyGrade(const string& input, const vector<int>& optionIndices, const vector<int>& correct) {
+    vector<int> user = legacyParse(input, optionIndices);
+    vector<int> userSorted = user;
+    vector<int> correctSorted = correct;
+    sort(userSorted.begin(), userSorted.end());
+    sort(correctSorted.begin(), correctSorted.end());
+    return userSorted == correctSorted && user.size() == correct.size();
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+
+    // ɴ룺4-6 ѡ1-3 𰸣ĸֻ
+    mt19937 rng(12345);
+    vector<string> inputs(count);
+    vector<vector<int>> orders(count);
+    vector<vector<int>> correctLists(count);
+    vector<uint32_t> correctMasks(count);
+    for (size_t i = 0; i < count; ++i) {
+        int options = 4 + rng() % 3;
+        orders[i].resize(options);
+        for (int j = 0; j < options; ++j) orders[i][j] = j;
+        shuffle(orders[i].begin(), orders[i].end(), rng);
+        int picks = 1 + rng() % 3;
+        for (int k = 0; k < picks; ++k) {
+            int idx = rng() % options;
+            int original = orders[i][idx];
+            if (correctMasks[i] & (1u << original)) continue;  // ظѡͬһ
+            if (!inputs[i].empty()) inputs[i] += rng() % 2 ? ", " : ",";
+            inputs[i] += rng() % 2 ? string(1, char('A' + idx)) : to_string(idx + 1);
+            correctLists[i].push_back(original);
+            correctMasks[i] |= 1u << original;
+        }
+    }
+
+    size_t legacyCorrect = 0, maskCorrect = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        legacyCorrect += legacyGrade(inputs[i], orders[i], correctLists[i]);
+    }
+    double legacyNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / count;
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        maskCorrect += parseUserAnswer(inputs[i], orders[i], QuestionType::CHOICE) == correctMasks[i];
+    }
+    double maskNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / count;
+
+    printf("answers:        %zu\n", count);
+    printf("legacy grading: %8.1f ns/answer (%zu correct)\n", legacyNs, legacyCorrect);
+    printf("mask grading:   %8.1f ns/answer (%zu correct)\n", maskNs, maskCorrect);
+    printf("speedup:        %8.2fx\n", legacyNs / maskNs);
+    return 0;
+}
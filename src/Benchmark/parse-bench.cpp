@@ -0,0 +1,112 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+
+#include "../Common/compiled-bank.h"
+
+using namespace std;
+
+// ɰʽgetline жȡƵ vector<string>ڶԱ
+struct LegacyQuestion {
+    string type;
+    vector<string> question;
+    vector<string> options;
+    vector<string> answers;
+    vector<int> correctAnswers;
+};
+
+size_t legacyLoad(const string& filename) {
+    vector<LegacyQuestion> questions;
+    ifstream file(filename);
+    string line;
+    LegacyQuestion q;
+    enum State { NONE, IN_QUESTION, IN_OPTIONS, IN_CORRECT, IN_ANSWER } state = NONE;
+    while (getline(file, line)) {
+        if (line == "#JUDGE" || line == "#CHOICE" || line == "#MULTICHOICE" || line == "#SUBJECTIVE") {
+            if (!q.question.empty()) questions.push_back(q);
+            q = LegacyQuestion();
+            q.type = line.substr(1);
+            state = IN_QUESTION;
+        } else if (line == "#OPTIONS") {
+            state = IN_OPTIONS;
+        } else if (line == "#CORRECT") {
+            state = IN_CORRECT;
+        } else if (line == "#ANSWER") {
+            state = IN_ANSWER;
+        } else if (line == "#END") {
+            questions.push_back(q);
+            q = LegacyQuestion();
+            state = NONE;
+        } else if (!line.empty()) {
+            if (state == IN_QUESTION) q.question.push_back(line);
+            else if (state == IN_OPTIONS) q.options.push_back(line);
+            else if (state == IN_ANSWER) q.answers.push_back(line);
+            else if (state == IN_CORRECT) q.correctAnswers.push_back(stoi(line) - 1);
+        }
+    }
+    if (!q.question.empty()) questions.push_back(q);
+    return questions.size();
+}
+
+template <typename F>
+double timeMs(int iterations, F&& fn) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: parse-bench <bank.txt>... [-n iterations]\n";
+        return 1;
+    }
+
+    int iterations = 200;
+    vector<string> files;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            iterations = max(1, atoi(argv[++i]));
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    printf("%-28s %10s %8s %12s %12s %8s %12s\n", "file", "bytes", "count", "legacy MB/s", "mmap MB/s", "speedup",
+           "qbk load us");
+    for (const auto& filename : files) {
+        QuestionBank bank;
+        if (!loadQuestions(filename, bank)) continue;
+        size_t bytes = bank.file.size();
+        size_t count = bank.questions.size();
+
+        volatile size_t sink = 0;
+        double legacyMs = timeMs(iterations, [&] { sink += legacyLoad(filename); });
+        double mmapMs = timeMs(iterations, [&] {
+            QuestionBank b;
+            loadQuestions(filename, b);
+            sink += b.questions.size();
+        });
+
+        //  obj-compile ɵ .qbk ʱͬʱͳƶļغʱ
+        string compiled = compiledBankPath(filename);
+        double compiledUs = -1;
+        QuestionBank probe;
+        if (loadCompiledBank(compiled, probe)) {
+            compiledUs = timeMs(iterations, [&] {
+                QuestionBank b;
+                loadCompiledBank(compiled, b);
+                sink += b.questions.size();
+            }) * 1000.0 / iterations;
+        }
+
+        double mb = double(bytes) * iterations / (1024.0 * 1024.0);
+        printf("%-28s %10zu %8zu %12.1f %12.1f %7.2fx", filename.c_str(), bytes, count,
+               mb / (legacyMs / 1000.0), mb / (mmapMs / 1000.0), legacyMs / mmapMs);
+        if (compiledUs >= 0) printf(" %12.1f", compiledUs);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <chrono>
+
+#include "../Common/text-encoding.h"
+
+using namespace std;
+
+// תѸ GBK ƴӵԼ size MBֱ GBK->UTF-8UTF-8->GBK
+// ͬС memcpy Ա
+// ÷transcode-bench ļ... [-m СMB]
+
+template <typename F>
+double bestMs(int iterations, F&& fn) {
+    double best = 1e300;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> files;
+    size_t megabytes = 16;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-m" && i + 1 < argc) megabytes = strtoul(argv[++i], nullptr, 10);
+        else files.push_back(arg);
+    }
+    if (files.empty()) {
+        cerr << "usage: transcode-bench bank.txt... [-m MB]\n";
+        return 1;
+    }
+
+    string sample;
+    for (const auto& f : files) {
+        ifstream in(f, ios::binary);
+        stringstream ss;
+        ss << in.rdbuf();
+        string text = ss.str();
+        // ֻƴ GBK ļUTF-8 ᱻ
+        if (detectEncoding(string_view(text).substr(0, kEncodingSampleBytes)) == TextEncoding::UTF8) continue;
+        sample += text;
+    }
+    if (sample.empty()) {
+        cerr << "no input\n";
+        return 1;
+    }
+    string gbk;
+    while (gbk.size() < megabytes << 20) gbk += sample;
+
+    string utf8, back, copy(gbk.size(), '\0');
+    double copyMs = bestMs(5, [&] { memcpy(&copy[0], gbk.data(), gbk.size()); });
+    double toUtf8Ms = bestMs(5, [&] { gbkToUtf8(gbk, utf8); });
+    double toGbkMs = bestMs(5, [&] { utf8ToGbk(utf8, back); });
+    size_t ascii = 0;
+    for (char c : gbk) ascii += static_cast<unsigned char>(c) < 0x80;
+
+    double mb = gbk.size() / 1048576.0;
+    printf("input:          %.1f MB GBK (%.0f%% ASCII), %.1f MB UTF-8\n", mb, ascii * 100.0 / gbk.size(),
+           utf8.size() / 1048576.0);
+    printf("memcpy:         %8.1f MB/s\n", mb / copyMs * 1000);
+    printf("GBK -> UTF-8:   %8.1f MB/s\n", mb / toUtf8Ms * 1000);
+    printf("UTF-8 -> GBK:   %8.1f MB/s\n", utf8.size() / 1048576.0 / toGbkMs * 1000);
+    printf("round trip:     %s\n", back == gbk ? "ok" : "MISMATCH");
+    return back == gbk ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+#ifndef ANSWER_JOURNAL_H
+#define ANSWER_JOURNAL_H
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "mapped-file.h"
+
+// ¼ⱾдỰֻһļ¼ڴ
+//  flushBytes ϴд flushInterval ʱһдرʱдʣಿ֡
+// ÿдĶ¼ֻڼ㣨ÿ checkpointBytes ֽں͹رʱ fsync
+//
+// ּ֧¼
+//   ı¼ԭ #USER_ANSWER/#CORRECT_ANSWER ʽɵ÷ƴú append
+//   Ƽ¼JournalRecordHeader + JournalEntry + ѡıУͣ
+//             ʱļĩβļ¼ڶȡʱ
+
+const uint32_t kJournalMagic = 0x314A5251;  // "QRJ1"
+
+struct JournalRecordHeader {
+    uint32_t magic;
+    uint32_t length;    // ֽ֮sizeof(JournalEntry) + ı
+    uint32_t checksum;  // ֮ȫֽڵ FNV-1a 32 λУ
+};
+
+struct JournalEntry {
+    uint64_t fingerprint;     // ĿָƣquestionFingerprint
+    int64_t time;             // ʱ䣨Unix 룩
+    uint32_t userAnswers;     // ûλͼ
+    uint32_t correctAnswers;  // ȷλͼ
+    uint8_t type;             // ͣQuestionType öֵ
+    uint8_t correct;          // Ƿ
+    uint16_t textBytes;       // ıȣû𰸣
+    uint32_t source;          // Դ
+};
+
+inline uint32_t journalChecksum(const char* data, size_t size) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        h = (h ^ static_cast<unsigned char>(data[i])) * 16777619u;
+    }
+    return h;
+}
+
+class AnswerJournal {
+public:
+    size_t flushBytes = 64 * 1024;
+    std::chrono::milliseconds flushInterval{1000};
+    size_t checkpointBytes = 1 << 20;
+
+    AnswerJournal() = default;
+    ~AnswerJournal() { close(); }
+
+    AnswerJournal(const AnswerJournal&) = delete;
+    AnswerJournal& operator=(const AnswerJournal&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        fd_ = ::_open(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, 0644);
+#else
+        fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+#endif
+        lastFlush_ = std::chrono::steady_clock::now();
+        return fd_ >= 0;
+    }
+
+    bool isOpen() const { return fd_ >= 0; }
+
+    // ׷һı¼
+    void append(std::string_view record) {
+        buffer_.append(record.data(), record.size());
+        maybeFlush();
+    }
+
+    // ׷һƼ¼
+    void append(JournalEntry entry, std::string_view text = {}) {
+        if (text.size() > 0xFFFF) text = text.substr(0, 0xFFFF);
+        entry.textBytes = static_cast<uint16_t>(text.size());
+        size_t start = buffer_.size();
+        JournalRecordHeader h{kJournalMagic, static_cast<uint32_t>(sizeof(entry) + text.size()), 0};
+        buffer_.append(reinterpret_cast<const char*>(&h), sizeof(h));
+        buffer_.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        buffer_.append(text.data(), text.size());
+        h.checksum = journalChecksum(buffer_.data() + start + sizeof(h), h.length);
+        memcpy(&buffer_[start], &h, sizeof(h));
+        maybeFlush();
+    }
+
+    // ѻдļں˻壬֤̣
+    void flush() {
+        lastFlush_ = std::chrono::steady_clock::now();
+        if (fd_ < 0 || buffer_.empty()) return;
+        const char* p = buffer_.data();
+        size_t left = buffer_.size();
+        while (left > 0) {
+#ifdef _WIN32
+            int n = ::_write(fd_, p, static_cast<unsigned>(left));
+#else
+            ssize_t n = ::write(fd_, p, left);
+#endif
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;  // дʧʱ¼Ӱ
+            }
+            p += n;
+            left -= static_cast<size_t>(n);
+        }
+        sinceCheckpoint_ += buffer_.size();
+        buffer_.clear();
+        if (sinceCheckpoint_ >= checkpointBytes) sync();
+    }
+
+    // 㣺д
+    void checkpoint() {
+        flush();
+        sync();
+    }
+
+    void close() {
+        if (fd_ < 0) return;
+        checkpoint();
+#ifdef _WIN32
+        ::_close(fd_);
+#else
+        ::close(fd_);
+#endif
+        fd_ = -1;
+    }
+
+private:
+    void maybeFlush() {
+        if (buffer_.size() >= flushBytes || std::chrono::steady_clock::now() - lastFlush_ >= flushInterval) {
+            flush();
+        }
+    }
+
+    void sync() {
+        if (fd_ < 0) return;
+#ifdef _WIN32
+        ::_commit(fd_);
+#else
+        ::fsync(fd_);
+#endif
+        sinceCheckpoint_ = 0;
+    }
+
+    int fd_ = -1;
+    std::string buffer_;
+    size_t sinceCheckpoint_ = 0;
+    std::chrono::steady_clock::time_point lastFlush_;
+};
+
+// ȡƴ¼Уʧܵļ¼ʱֹͣضȡļ¼
+template <typename F>
+size_t readJournal(const std::string& path, F&& fn) {
+    MappedFile file;
+    if (!file.open(path)) return 0;
+    const char* p = file.data();
+    const char* end = p + file.size();
+    size_t count = 0;
+    while (static_cast<size_t>(end - p) >= sizeof(JournalRecordHeader)) {
+        JournalRecordHeader h;
+        memcpy(&h, p, sizeof(h));
+        if (h.magic != kJournalMagic || h.length < sizeof(JournalEntry) ||
+            h.length > static_cast<size_t>(end - p) - sizeof(h)) {
+            break;
+        }
+        const char* body = p + sizeof(h);
+        if (journalChecksum(body, h.length) != h.checksum) break;
+        JournalEntry entry;
+        memcpy(&entry, body, sizeof(entry));
+        size_t textBytes = h.length - sizeof(entry);
+        fn(entry, std::string_view(body + sizeof(entry), textBytes));
+        ++count;
+        p = body + h.length;
+    }
+    return count;
+}
+
+#endif  // ANSWER_JOURNAL_H
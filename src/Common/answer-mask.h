@@ -0,0 +1,90 @@
+#ifndef ANSWER_MASK_H
+#define ANSWER_MASK_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "question-type.h"
+
+// ͳһ uint32_t λͼʾ i λΪ 1 ʾѡ˵ i ѡ0ʼ
+// зֻȽλͼǷ
+
+// ĸA/B/C/DתΪ
+inline int charToIndex(char c) {
+    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');  // תΪд
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    }
+    return -1;  // Чַ
+}
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// û𰸣ֺ֧ĸԭʼѡɵλͼڴ
+// optionIndices[k] ʾڵ k λõԭʼѡš T Ǳڳ
+// ͷзʱѭֻʵӦ͵ķ֧
+template <QuestionType T>
+uint32_t parseUserAnswerAs(std::string_view input, const std::vector<int>& optionIndices) {
+    uint32_t mask = 0;
+    auto select = [&](int idx) {
+        // ǷЧ
+        if (idx >= 0 && idx < static_cast<int>(optionIndices.size()) && optionIndices[idx] < 32) {
+            mask |= 1u << optionIndices[idx];
+        }
+    };
+
+    if constexpr (T == QuestionType::JUDGE) {
+        // ж⴦T/F1/2Կո
+        char c = 0;
+        int seen = 0;
+        for (char ch : input) {
+            if (isBlank(ch)) continue;
+            c = ch;
+            ++seen;
+        }
+        if (seen != 1) return 0;
+        if (c == 'T' || c == 't' || c == '1') select(0);
+        else if (c == 'F' || c == 'f' || c == '2') select(1);
+        return mask;
+    } else if constexpr (!QuestionTypeTraits<T>::info.objective) {
+        return mask;  // ûѡ
+    }
+
+    size_t pos = 0;
+    while (pos < input.size()) {
+        // ÿŷָƬΣ루1/2/3/4ĸ루A/B/C/DƬڵĿո񱻺
+        int number = 0;
+        int letter = -1;
+        bool hasDigit = false;
+        bool first = true;
+        for (; pos < input.size() && input[pos] != ','; ++pos) {
+            char c = input[pos];
+            if (isBlank(c)) continue;
+            if (first) {
+                hasDigit = (c >= '0' && c <= '9');
+                if (!hasDigit) letter = charToIndex(c);
+                first = false;
+            }
+            if (hasDigit && c >= '0' && c <= '9' && number < 1000) number = number * 10 + (c - '0');
+        }
+        ++pos;  // 
+        if (hasDigit) {
+            select(number - 1);
+        } else if (!first) {
+            select(letter);
+        }
+    }
+    return mask;
+}
+
+// зʱʹãͷһ
+inline uint32_t parseUserAnswer(std::string_view input, const std::vector<int>& optionIndices, QuestionType type) {
+    return visitQuestionType(type, [&](auto tag) {
+        return parseUserAnswerAs<decltype(tag)::value>(input, optionIndices);
+    });
+}
+
+#endif  // ANSWER_MASK_H
@@ -0,0 +1,249 @@
+#ifndef ANSWER_SIMILARITY_H
+#define ANSWER_SIMILARITY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dedup-index.h"
+
+// Զ֣û𰸵ÿһο𰸵ÿҪȽƶȣÿҪһû𰸡
+// ƶۺֶ GBK ԭϼ㣺
+//   ʣӢıʶ֣תСдϵ Dice ϵʺҪеĹؼ
+//   ַ֣һַϵ Dice ϵʺı
+//   ༭룺ַȽϣʺ listIter.hasNext() Ҫдһģһմ
+// ȽǰȥհסӢתСдȫĸֺͷתɰǡο𰸵ַСԪ顢ʼϺ
+// ༭õλڹ AnswerScorer ʱãʱÿοֻһΡ
+
+const double kPointCovered = 0.6;  // ƶȴﵽֵҪ
+
+// 淶ַУASCII ΪһֽڣGBK ˫ַֽΪ (ֽ << 8) | βֽ
+inline void normalizeUnits(std::string_view text, std::vector<uint16_t>& units) {
+    units.clear();
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    size_t n = text.size();
+    for (size_t i = 0; i < n; ++i) {
+        unsigned c = p[i];
+        if (c >= 0x81 && c <= 0xFE && i + 1 < n) {
+            unsigned trail = p[++i];
+            if (c == 0xA1 && trail == 0xA1) continue;  // ȫǿո
+            if (c == 0xA3 && trail >= 0xA1 && trail <= 0xFE) {
+                c = trail - 0x80;  // ȫ ASCII
+            } else {
+                units.push_back(static_cast<uint16_t>((c << 8) | trail));
+                continue;
+            }
+        }
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') continue;
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        units.push_back(static_cast<uint16_t>(c));
+    }
+}
+
+// ַԪ飨ȥأֻһַʱȡַ
+inline void charBigrams(const std::vector<uint16_t>& units, std::vector<uint32_t>& grams) {
+    grams.clear();
+    if (units.size() == 1) grams.push_back(units[0]);
+    for (size_t i = 1; i < units.size(); ++i) grams.push_back((uint32_t(units[i - 1]) << 16) | units[i]);
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+// ӢıʶֵĹϣȥأ
+inline void wordHashes(const std::vector<uint16_t>& units, std::vector<uint64_t>& words) {
+    words.clear();
+    auto isWord = [](uint16_t c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '_'; };
+    for (size_t i = 0; i < units.size();) {
+        if (!isWord(units[i])) {
+            ++i;
+            continue;
+        }
+        uint64_t h = kFnvOffset;
+        for (; i < units.size() && isWord(units[i]); ++i) h = (h ^ units[i]) * kFnvPrime;
+        words.push_back(mix64(h));
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+}
+
+// 򼯺ϵ Dice ϵ
+template <typename T>
+double diceCoefficient(const std::vector<T>& a, const std::vector<T>& b) {
+    if (a.empty() || b.empty()) return 0;
+    size_t common = 0;
+    for (size_t i = 0, j = 0; i < a.size() && j < b.size();) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            ++common;
+            ++i;
+            ++j;
+        }
+    }
+    return 2.0 * common / (a.size() + b.size());
+}
+
+// Myers λб༭루Hyyro ķֿʽģʽÿ 64 ַռһ֣
+// ıÿַÿһγελ㣬̬滮ͬ
+class EditPattern {
+public:
+    EditPattern() = default;
+
+    explicit EditPattern(const std::vector<uint16_t>& pattern) : length_(pattern.size()) {
+        words_ = (length_ + 63) / 64;
+        symbols_ = pattern;
+        std::sort(symbols_.begin(), symbols_.end());
+        symbols_.erase(std::unique(symbols_.begin(), symbols_.end()), symbols_.end());
+        masks_.assign(symbols_.size() * words_, 0);
+        for (size_t i = 0; i < length_; ++i) {
+            size_t s = std::lower_bound(symbols_.begin(), symbols_.end(), pattern[i]) - symbols_.begin();
+            masks_[s * words_ + i / 64] |= 1ull << (i % 64);
+        }
+    }
+
+    size_t length() const { return length_; }
+
+    size_t distance(const std::vector<uint16_t>& text) const {
+        if (length_ == 0) return text.size();
+        std::vector<uint64_t> pv(words_, ~0ull), mv(words_, 0);
+        const uint64_t lastBit = 1ull << ((length_ - 1) % 64);
+        size_t score = length_;
+        for (uint16_t c : text) {
+            auto it = std::lower_bound(symbols_.begin(), symbols_.end(), c);
+            const uint64_t* eq =
+                it != symbols_.end() && *it == c ? &masks_[(it - symbols_.begin()) * words_] : nullptr;
+            int carry = 1;  //  0  0, 1, 2...ÿбǰһж 1
+            for (size_t w = 0; w < words_; ++w) {
+                uint64_t e = eq ? eq[w] : 0;
+                uint64_t p = pv[w], m = mv[w];
+                uint64_t xv = e | m;
+                if (carry < 0) e |= 1;
+                uint64_t xh = (((e & p) + p) ^ p) | e;
+                uint64_t ph = m | ~(xh | p);
+                uint64_t mh = p & xh;
+                uint64_t bottom = w + 1 == words_ ? lastBit : 1ull << 63;
+                int out = (ph & bottom) ? 1 : (mh & bottom) ? -1 : 0;
+                ph <<= 1;
+                mh <<= 1;
+                if (carry < 0) mh |= 1;
+                else if (carry > 0) ph |= 1;
+                pv[w] = mh | ~(xv | ph);
+                mv[w] = ph & xv;
+                carry = out;
+            }
+            score += carry;
+        }
+        return score;
+    }
+
+private:
+    size_t length_ = 0;
+    size_t words_ = 0;
+    std::vector<uint16_t> symbols_;  // ģʽгֵַ
+    std::vector<uint64_t> masks_;    // symbols_[s] λõλÿַ words_ 
+};
+
+// һд𰸵Ԥ
+struct AnswerSignature {
+    std::vector<uint16_t> units;
+    std::vector<uint32_t> grams;
+    std::vector<uint64_t> words;
+
+    explicit AnswerSignature(std::string_view text) {
+        normalizeUnits(text, units);
+        charBigrams(units, grams);
+        wordHashes(units, words);
+    }
+};
+
+struct PointScore {
+    int userLine = -1;        // ԵûУ 0 ʼ-1 ʾû
+    double similarity = 0;
+};
+
+struct AnswerScore {
+    std::vector<PointScore> points;  // ο𰸵һһӦ
+    size_t covered = 0;              // ƶȴﵽ kPointCovered Ҫ
+    double score = 0;                // Ҫ÷ֵƽֵ0-1ûдҪ 0
+};
+
+class AnswerScorer {
+public:
+    AnswerScorer() = default;
+
+    // references ǲοҪ㣨Span<string_view>vector<string> ȣÿһհвҪ
+    template <typename Lines>
+    explicit AnswerScorer(const Lines& references) {
+        for (const auto& line : references) {
+            refs_.emplace_back(std::string_view(line));
+            patterns_.emplace_back(refs_.back().units);
+            if (!refs_.back().units.empty()) ++points_;
+        }
+    }
+
+    size_t points() const { return points_; }
+
+    // ο𰸵 i Ҫһû𰸵ƶȣ0-1ʵ Dice ϵ
+    // ֵ Dice ϵͱ༭ƶȵƽֵȡϴ
+    double similarity(size_t i, const AnswerSignature& user) const {
+        const AnswerSignature& ref = refs_[i];
+        if (user.units.empty() || ref.units.empty()) return 0;
+        double words = ref.words.empty() || user.words.empty() ? 0 : diceCoefficient(ref.words, user.words);
+        double chars = diceCoefficient(ref.grams, user.grams);
+        size_t longest = std::max(ref.units.size(), user.units.size());
+        double edit = 1.0 - static_cast<double>(patterns_[i].distance(user.units)) / longest;
+        return std::max(words, (chars + edit) / 2);
+    }
+
+    // ƶȴӸߵ̰ԣÿûӦһҪ
+    template <typename Lines>
+    AnswerScore score(const Lines& userLines) const {
+        AnswerScore result;
+        result.points.resize(refs_.size());
+        std::vector<AnswerSignature> users;
+        for (const auto& line : userLines) users.emplace_back(std::string_view(line));
+
+        struct Pair {
+            double similarity;
+            uint32_t point, user;
+        };
+        std::vector<Pair> pairs;
+        for (size_t i = 0; i < refs_.size(); ++i) {
+            for (size_t j = 0; j < users.size(); ++j) {
+                double s = similarity(i, users[j]);
+                if (s > 0) pairs.push_back({s, static_cast<uint32_t>(i), static_cast<uint32_t>(j)});
+            }
+        }
+        std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) {
+            return a.similarity != b.similarity ? a.similarity > b.similarity
+                                                : (a.point != b.point ? a.point < b.point : a.user < b.user);
+        });
+        std::vector<char> userUsed(users.size(), 0);
+        for (const Pair& p : pairs) {
+            PointScore& point = result.points[p.point];
+            if (point.userLine >= 0 || userUsed[p.user]) continue;
+            point = {static_cast<int>(p.user), p.similarity};
+            userUsed[p.user] = 1;
+        }
+
+        double sum = 0;
+        for (const PointScore& point : result.points) {
+            if (point.similarity < kPointCovered) continue;
+            ++result.covered;
+            sum += point.similarity;
+        }
+        result.score = points_ ? sum / points_ : 0;
+        return result;
+    }
+
+private:
+    std::vector<AnswerSignature> refs_;
+    std::vector<EditPattern> patterns_;
+    size_t points_ = 0;
+};
+
+#endif  // ANSWER_SIMILARITY_H
@@ -0,0 +1,127 @@
+#ifndef BANK_SET_H
+#define BANK_SET_H
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "compiled-bank.h"
+#include "dedup-index.h"
+#include "thread-pool.h"
+
+// ϲʱظĿ
+struct DuplicateRecord {
+    Question question;      // Ŀ
+    uint32_t number;        // Դǵڼ⣨1ʼ
+    size_t keptIndex;       // ǵ BankSet::questions е±
+    uint32_t keptNumber;    // ǵԴǵڼ
+};
+
+// ϲĿϣQuestion::source  files е±
+struct BankSet {
+    std::vector<std::string> files;
+    std::vector<QuestionBank> banks;
+    std::vector<Question> questions;
+    std::vector<DuplicateRecord> duplicates;
+};
+
+// ͨƥ䣬֧ *  ?
+inline bool wildcardMatch(std::string_view pattern, std::string_view name) {
+    size_t p = 0, n = 0, star = std::string_view::npos, mark = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = n;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            n = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+// չļеֻͨƥļ֣ ../Objective-Question/java*.txtȥ
+inline std::vector<std::string> expandBankPatterns(const std::vector<std::string>& patterns) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    for (const auto& pattern : patterns) {
+        if (pattern.find_first_of("*?") == std::string::npos) {
+            files.push_back(pattern);
+            continue;
+        }
+        fs::path path(pattern);
+        fs::path dir = path.has_parent_path() ? path.parent_path() : fs::path(".");
+        std::string namePattern = path.filename().string();
+        std::vector<std::string> matched;
+        std::error_code ec;
+        for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+            std::string name = it->path().filename().string();
+            if (wildcardMatch(namePattern, name)) {
+                matched.push_back(path.has_parent_path() ? (dir / name).string() : name);
+            }
+        }
+        std::sort(matched.begin(), matched.end());
+        files.insert(files.end(), matched.begin(), matched.end());
+    }
+
+    std::vector<std::string> unique;
+    for (const auto& f : files) {
+        if (std::find(unique.begin(), unique.end(), f) == unique.end()) unique.push_back(f);
+    }
+    return unique;
+}
+
+// мضⲢļ˳ϲָͬĿֻһγֵģ duplicates
+inline bool loadBanks(const std::vector<std::string>& files, BankSet& set,
+                      unsigned threads = defaultThreadCount()) {
+    set.files = files;
+    set.banks.clear();
+    set.banks.resize(files.size());
+    set.questions.clear();
+    set.duplicates.clear();
+
+    std::vector<char> ok(files.size(), 0);
+    parallelFor(files.size(), [&](size_t i) { ok[i] = loadBank(files[i], set.banks[i]); }, threads);
+
+    size_t total = 0;
+    for (const auto& bank : set.banks) total += bank.questions.size();
+    set.questions.reserve(total);
+
+    // ָƼֻĿݣⲢм
+    std::vector<std::vector<uint64_t>> fingerprints(set.banks.size());
+    parallelFor(set.banks.size(), [&](size_t i) {
+        const auto& qs = set.banks[i].questions;
+        fingerprints[i].resize(qs.size());
+        for (size_t j = 0; j < qs.size(); ++j) fingerprints[i][j] = questionFingerprint(qs[j]);
+    }, threads);
+
+    FingerprintIndex index(total);
+    std::vector<uint32_t> numbers;  // set.questions ÿԴ
+    numbers.reserve(total);
+    for (size_t i = 0; i < set.banks.size(); ++i) {
+        const auto& qs = set.banks[i].questions;
+        for (size_t j = 0; j < qs.size(); ++j) {
+            Question q = qs[j];
+            q.source = static_cast<uint32_t>(i);
+            long long kept = index.insert(fingerprints[i][j], static_cast<uint32_t>(set.questions.size()));
+            if (kept >= 0) {
+                set.duplicates.push_back({q, static_cast<uint32_t>(j + 1), static_cast<size_t>(kept), numbers[kept]});
+                continue;
+            }
+            set.questions.push_back(q);
+            numbers.push_back(static_cast<uint32_t>(j + 1));
+        }
+    }
+    return std::any_of(ok.begin(), ok.end(), [](char c) { return c != 0; });
+}
+
+#endif  // BANK_SET_H
@@ -0,0 +1,290 @@
+#ifndef BANK_SNAPSHOT_H
+#define BANK_SNAPSHOT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "bank-set.h"
+#include "bank-store.h"
+#include "dedup-index.h"
+
+// ȼأմ޸ģʹͨ shared_ptr С
+// BankWatcher ļLinux  inotifyƽ̨ʱļȣobj-insert ȹ
+// ĩβ׷Ŀֻ׷ӵĲ֣¿ոĿ±꣬ıгɿչã
+//  atomic_store 滻ǰաѾȡɿյĻỰʹþɿգᱻ½
+// Ŀ޸ġɾļضϣѹʱں̨¼ء
+
+struct BankSnapshot {
+    std::vector<std::string> files;
+    std::vector<Question> questions;                   // Question::source  files е±
+    std::vector<uint32_t> objective;                   // ͹ questions е±
+    TypePartitions byType;                             // ͷ±
+    std::vector<std::shared_ptr<const void>> storage;  // Ŀͼָıгأ¾ɿչ
+    std::vector<uint64_t> loadedBytes;                 // ÿļѾĳ
+    std::vector<uint32_t> nextRecord;                  // ÿļһļ¼ţ bank-store.h
+    uint64_t generation = 0;                           // ÿһ¿ռ 1
+};
+
+inline void indexObjective(BankSnapshot& snapshot, size_t from) {
+    for (size_t i = from; i < snapshot.questions.size(); ++i) {
+        QuestionType type = snapshot.questions[i].type;
+        if (isObjective(type)) snapshot.objective.push_back(static_cast<uint32_t>(i));
+        snapshot.byType[static_cast<size_t>(type)].push_back(static_cast<uint32_t>(i));
+    }
+}
+
+// ǰ bytes ֽõļ¼øǵʱֱȡɨ־Ŀ
+inline uint32_t storeRecordCount(const std::string& filename, uint64_t bytes) {
+    StoreIndexHeader h;
+    bool current = false;
+    if (readStoreIndexHeader(filename, h, current) && current && h.logBytes == bytes) return h.count;
+    MappedFile file;
+    if (!file.open(filename)) return 0;
+    std::vector<StoreIndexEntry> entries;
+    StoreIndexHeader scanned{};
+    scanStoreLog(file.view().substr(0, static_cast<size_t>(bytes)), 0, entries, scanned);
+    return static_cast<uint32_t>(entries.size());
+}
+
+inline std::shared_ptr<BankSnapshot> loadBankSnapshot(const std::vector<std::string>& files) {
+    auto snapshot = std::make_shared<BankSnapshot>();
+    // ȼļټأڼ׷ӵĿ´μʱٶһ飬ָȥظ
+    for (const auto& f : files) {
+        std::error_code ec;
+        uint64_t size = std::filesystem::file_size(f, ec);
+        snapshot->loadedBytes.push_back(ec ? 0 : size);
+    }
+    auto set = std::make_shared<BankSet>();
+    if (!loadBanks(files, *set)) return nullptr;
+    snapshot->files = files;
+    snapshot->questions = std::move(set->questions);
+    snapshot->storage.push_back(std::move(set));
+    for (size_t i = 0; i < files.size(); ++i) {
+        snapshot->nextRecord.push_back(storeRecordCount(files[i], snapshot->loadedBytes[i]));
+    }
+    indexObjective(*snapshot, 0);
+    return snapshot;
+}
+
+// ĩβ׷ӵһı¼ĳȣдһļ¼´Ρ
+// nextRecord ǰɾĿ޸ʱ rewrites Ϊ trueҪ¼
+inline size_t scanAppendedText(std::string_view text, uint32_t& nextRecord, bool& rewrites) {
+    size_t p = 0, complete = 0;
+    uint32_t next = nextRecord;
+    bool inQuestion = false;  // ûм¼ͷĿ #END һΪֹ
+    auto commit = [&](size_t end) {
+        complete = end;
+        nextRecord = next;
+    };
+    while (p < text.size()) {
+        size_t nl = text.find('\n', p);
+        if (nl == std::string_view::npos) break;  // һлûд
+        std::string_view line = trimLineEnd(text.substr(p, nl - p));
+        size_t after = nl + 1;
+        uint32_t id, bytes;
+        bool put;
+        if (parseRecordHeader(line, id, put, bytes)) {
+            if (inQuestion) commit(p);
+            if (put && after + bytes > text.size()) break;
+            if (!put || id < next) rewrites = true;
+            else next = id + 1;
+            p = put ? after + bytes : after;
+            inQuestion = false;
+            commit(p);
+            continue;
+        }
+        if (isQuestionMarker(line)) {
+            if (inQuestion) commit(p);
+            ++next;
+            inQuestion = true;
+        } else if (line == "#END" || !inQuestion) {
+            inQuestion = false;
+            commit(after);
+        }
+        p = after;
+    }
+    return complete;
+}
+
+inline bool readFileRange(const std::string& filename, uint64_t offset, uint64_t length, std::string& out) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.seekg(static_cast<std::streamoff>(offset))) return false;
+    out.resize(static_cast<size_t>(length));
+    in.read(&out[0], static_cast<std::streamsize>(length));
+    out.resize(static_cast<size_t>(in.gcount()));
+    return true;
+}
+
+class BankWatcher {
+public:
+    // ¿շã(¿, , Ƿ¼)
+    using Listener = std::function<void(const BankSnapshot&, size_t, bool)>;
+
+    explicit BankWatcher(std::shared_ptr<const BankSnapshot> snapshot) : snapshot_(std::move(snapshot)) {}
+    ~BankWatcher() { stop(); }
+
+    BankWatcher(const BankWatcher&) = delete;
+    BankWatcher& operator=(const BankWatcher&) = delete;
+
+    // ǰգһϰӦͬһգҪÿȡ
+    std::shared_ptr<const BankSnapshot> snapshot() const { return std::atomic_load(&snapshot_); }
+
+    // ں̨̼߳ļ
+    void start(Listener listener = {}) {
+        stop();
+        stopping_ = false;
+        worker_ = std::thread([this, listener] { run(listener); });
+    }
+
+    void stop() {
+        stopping_ = true;
+        if (worker_.joinable()) worker_.join();
+    }
+
+    // һ⣬б仯ʱ¿գĿ¼ʱ true
+    // ͬһʱֻһ̵߳
+    bool refresh(size_t& added, bool& reloaded) {
+        std::shared_ptr<const BankSnapshot> current = snapshot();
+        const auto& files = current->files;
+        std::vector<std::string> tails(files.size());
+        std::vector<uint64_t> loaded = current->loadedBytes;
+        std::vector<uint32_t> nextRecord = current->nextRecord;
+        bool changed = false;
+        reloaded = false;
+        for (size_t i = 0; i < files.size() && !reloaded; ++i) {
+            std::error_code ec;
+            uint64_t size = std::filesystem::file_size(files[i], ec);
+            if (ec || size == loaded[i]) continue;
+            if (size < loaded[i]) {
+                reloaded = true;  // ضϻѹ滻
+                break;
+            }
+            if (!readFileRange(files[i], loaded[i], size - loaded[i], tails[i])) continue;
+            bool rewrites = false;
+            size_t complete = scanAppendedText(tails[i], nextRecord[i], rewrites);
+            if (rewrites) reloaded = true;
+            tails[i].resize(complete);
+            loaded[i] += complete;
+            changed |= complete > 0;
+        }
+
+        std::shared_ptr<BankSnapshot> next;
+        if (reloaded) {
+            next = loadBankSnapshot(files);
+            if (!next) return false;
+            fingerprints_.reset();
+        } else if (changed) {
+            next = std::make_shared<BankSnapshot>(*current);
+            next->loadedBytes = std::move(loaded);
+            next->nextRecord = std::move(nextRecord);
+            appendTails(*next, tails);
+        } else {
+            return false;
+        }
+        next->generation = current->generation + 1;
+        added = next->questions.size() > current->questions.size() ? next->questions.size() - current->questions.size()
+                                                                   : 0;
+        std::atomic_store(&snapshot_, std::shared_ptr<const BankSnapshot>(std::move(next)));
+        return reloaded || added > 0;
+    }
+
+private:
+    // ׷ӵıӵĩβĿָͬ loadBanks ȥһ£
+    void appendTails(BankSnapshot& snapshot, std::vector<std::string>& tails) {
+        if (!fingerprints_) {
+            fingerprints_ = std::make_unique<FingerprintIndex>(snapshot.questions.size());
+            for (size_t i = 0; i < snapshot.questions.size(); ++i) {
+                fingerprints_->insert(questionFingerprint(snapshot.questions[i]), static_cast<uint32_t>(i));
+            }
+        }
+        size_t before = snapshot.questions.size();
+        for (size_t i = 0; i < tails.size(); ++i) {
+            if (tails[i].empty()) continue;
+            auto bank = std::make_shared<QuestionBank>();
+            if (detectEncoding(std::string_view(tails[i]).substr(0, kEncodingSampleBytes)) == TextEncoding::UTF8) {
+                utf8ToGbk(tails[i], bank->converted);
+            } else {
+                bank->converted = std::move(tails[i]);
+            }
+            parseQuestions(bank->converted, *bank);
+            for (Question q : bank->questions) {
+                q.source = static_cast<uint32_t>(i);
+                uint32_t index = static_cast<uint32_t>(snapshot.questions.size());
+                if (fingerprints_->insert(questionFingerprint(q), index) >= 0) continue;
+                snapshot.questions.push_back(q);
+            }
+            snapshot.storage.push_back(std::move(bank));
+        }
+        indexObjective(snapshot, before);
+    }
+
+    void run(const Listener& listener) {
+        int fd = -1;
+#ifdef __linux__
+        // ڵĿ¼׷д루IN_MODIFYѹ滻IN_MOVED_TOյ¼
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        std::set<std::string> dirs;
+        for (const auto& f : snapshot()->files) {
+            std::string dir = std::filesystem::path(f).parent_path().string();
+            dirs.insert(dir.empty() ? "." : dir);
+        }
+        for (const auto& dir : dirs) {
+            if (fd >= 0 && inotify_add_watch(fd, dir.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+        auto lastCheck = std::chrono::steady_clock::now();
+        while (!stopping_) {
+            bool wake = false;
+#ifdef __linux__
+            if (fd >= 0) {
+                pollfd pfd{fd, POLLIN, 0};
+                if (::poll(&pfd, 1, 200) > 0) {
+                    // һд볣ж¼ԵƬ̺һ
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    char buf[4096];
+                    while (::read(fd, buf, sizeof(buf)) > 0) {}
+                    wake = true;
+                }
+            }
+#endif
+            if (fd < 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                wake = std::chrono::steady_clock::now() - lastCheck >= std::chrono::seconds(1);
+            }
+            if (!wake) continue;
+            lastCheck = std::chrono::steady_clock::now();
+            size_t added = 0;
+            bool reloaded = false;
+            if (refresh(added, reloaded) && listener) listener(*snapshot(), added, reloaded);
+        }
+#ifdef __linux__
+        if (fd >= 0) ::close(fd);
+#endif
+    }
+
+    std::shared_ptr<const BankSnapshot> snapshot_;
+    std::unique_ptr<FingerprintIndex> fingerprints_;  // ֻڼ߳ʹ
+    std::atomic<bool> stopping_{false};
+    std::thread worker_;
+};
+
+#endif  // BANK_SNAPSHOT_H
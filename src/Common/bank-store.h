@@ -0,0 +1,570 @@
+#ifndef BANK_STORE_H
+#define BANK_STORE_H
+
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "mapped-file.h"
+#include "question-bank.h"
+
+// 洢.txt Ȿֻ׷ӵļ¼־Աߵ .qidx ǰеƫ
+//
+// ־ÿ¼һм¼ͷʼ
+//   #RECORD <> PUT <ֽ>    ı#JUDGE ... #ENDֽΪı
+//   #RECORD <> DEL             ɾ
+// ޸Ŀ׷ͬһŵ PUTɰ汾ΪʧЧ¼ûм¼ͷĿԭ⡢ֹӵģ
+// ˳αš¼ͷԽֻһͨ # Уû޸ĻɾĿԿֱӽ
+//
+// ֣StoreIndexHeader + StoreIndexEntry[count]ÿһ
+// ׷ӡ޸ġɾֻд־ĩβжӦһС޹أ
+// ʱȺ˶ÿһ־еλǷһĿͷ storeIndexMatches
+// ˶ͨ־¼ĸ类ɰ湤׷ӹʱֻɨĲ֣ͷؽ
+// ʧЧ¼Ч¼ʱں̨߳ѹ˳дЧ¼滻ԭļ
+const char kStoreIndexMagic[4] = {'Q', 'I', 'D', 'X'};
+const uint16_t kStoreIndexVersion = 1;
+const uint64_t kStoreCompactMinBytes = 16 * 1024;  // ʧЧ¼ڴֵʱѹ
+const uint32_t kStoreMaxId = 1u << 24;
+
+struct StoreIndexHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t count;      // ɾģ
+    uint32_t liveCount;
+    uint64_t logBytes;   // ǵ־
+    uint64_t liveBytes;
+    uint64_t deadBytes;
+};
+
+struct StoreIndexEntry {
+    uint64_t offset;  // Ŀı־еλã¼ͷ֮
+    uint32_t length;
+    uint32_t live;
+};
+
+//  xxx.txt  xxx.qidx
+inline std::string storeIndexPath(const std::string& filename) {
+    std::string path = filename;
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".txt") == 0) {
+        path.resize(path.size() - 4);
+    }
+    return path + ".qidx";
+}
+
+// ¼ͷʽʱ falseDEL ¼ bytes Ϊ 0
+inline bool parseRecordHeader(std::string_view line, uint32_t& id, bool& put, uint32_t& bytes) {
+    if (line.substr(0, 8) != "#RECORD ") return false;
+    const char* p = line.data() + 8;
+    const char* end = line.data() + line.size();
+    auto r = std::from_chars(p, end, id);
+    if (r.ec != std::errc() || r.ptr == end || *r.ptr != ' ' || id >= kStoreMaxId) return false;
+    std::string_view rest(r.ptr + 1, end - r.ptr - 1);
+    bytes = 0;
+    if (rest == "DEL") {
+        put = false;
+        return true;
+    }
+    if (rest.substr(0, 4) != "PUT ") return false;
+    put = true;
+    r = std::from_chars(rest.data() + 4, rest.data() + rest.size(), bytes);
+    return r.ec == std::errc() && r.ptr == rest.data() + rest.size();
+}
+
+inline void applyStorePut(std::vector<StoreIndexEntry>& entries, StoreIndexHeader& h, uint32_t id,
+                          uint64_t offset, uint32_t length) {
+    if (id >= entries.size()) entries.resize(id + 1, StoreIndexEntry{0, 0, 0});
+    StoreIndexEntry& e = entries[id];
+    if (e.live) {
+        h.deadBytes += e.length;
+        h.liveBytes -= e.length;
+        --h.liveCount;
+    }
+    e = {offset, length, 1};
+    h.liveBytes += length;
+    ++h.liveCount;
+    h.count = static_cast<uint32_t>(entries.size());
+}
+
+inline void applyStoreDelete(std::vector<StoreIndexEntry>& entries, StoreIndexHeader& h, uint32_t id) {
+    if (id >= entries.size() || !entries[id].live) return;
+    StoreIndexEntry& e = entries[id];
+    h.deadBytes += e.length;
+    h.liveBytes -= e.length;
+    --h.liveCount;
+    e.live = 0;
+}
+
+// ɨ־д base ʼһ textеļ¼Ӧõ
+// ¼Ľβλã textĩβдһļ¼ʱ֮ͣǰ
+inline size_t scanStoreLog(std::string_view text, uint64_t base, std::vector<StoreIndexEntry>& entries,
+                           StoreIndexHeader& h) {
+    auto lineAt = [&](size_t p, size_t& next) {
+        size_t nl = text.find('\n', p);
+        next = nl == std::string_view::npos ? text.size() : nl + 1;
+        return trimLineEnd(text.substr(p, (nl == std::string_view::npos ? text.size() : nl) - p));
+    };
+
+    size_t p = 0;
+    while (p < text.size()) {
+        size_t next;
+        std::string_view line = lineAt(p, next);
+        uint32_t id, bytes;
+        bool put;
+        if (parseRecordHeader(line, id, put, bytes)) {
+            if (next == text.size() && text.back() != '\n') return p;
+            if (!put) {
+                applyStoreDelete(entries, h, id);
+                p = next;
+                continue;
+            }
+            if (next + bytes > text.size()) return p;
+            applyStorePut(entries, h, id, base + next, bytes);
+            p = next + bytes;
+            continue;
+        }
+        if (isQuestionMarker(line)) {
+            // ûм¼ͷĿ #END УΪֹһĿ/¼֮ǰ
+            size_t end = next;
+            while (end < text.size()) {
+                size_t after;
+                std::string_view l = lineAt(end, after);
+                if (l == "#END") {
+                    end = after;
+                    break;
+                }
+                if (isQuestionMarker(l) || l.substr(0, 8) == "#RECORD ") break;
+                end = after;
+            }
+            applyStorePut(entries, h, static_cast<uint32_t>(entries.size()), base + p, static_cast<uint32_t>(end - p));
+            p = end;
+            continue;
+        }
+        p = next;
+    }
+    return text.size();
+}
+
+// ˳ЧĿı׷ӵ outÿԻнβ
+inline void appendLiveRecords(std::string_view log, const std::vector<StoreIndexEntry>& entries, std::string& out) {
+    for (const auto& e : entries) {
+        if (!e.live || e.offset + e.length > log.size()) continue;
+        out.append(log.data() + e.offset, e.length);
+        if (e.length > 0 && out.back() != '\n') out += '\n';
+    }
+}
+
+// ȡļͷжǷ񸲸־־֮ûбд׷ӹ
+inline bool readStoreIndexHeader(const std::string& filename, StoreIndexHeader& h, bool& current) {
+    namespace fs = std::filesystem;
+    std::string path = storeIndexPath(filename);
+    std::ifstream in(path, std::ios::binary);
+    if (!in || !in.read(reinterpret_cast<char*>(&h), sizeof(h))) return false;
+    if (memcmp(h.magic, kStoreIndexMagic, 4) != 0 || h.version != kStoreIndexVersion) return false;
+    std::error_code ec;
+    uint64_t logSize = fs::file_size(filename, ec);
+    if (ec || logSize < h.logBytes) return false;
+    current = logSize == h.logBytes && fs::last_write_time(filename, ec) <= fs::last_write_time(path, ec);
+    return true;
+}
+
+// Ƿ־ǰ logBytes ֽڶӦֹм롢ɾ޸Ŀԭλû䵽Ŀм䡣
+// ÿһҪ㣺¼ͷĿǰһͬһšֽͬ PUT ¼ͷûм¼ͷĿ
+// ׵ͱǿʼβһûлзʱ⣩ֻλòȡĿݣĿ
+inline bool storeIndexMatches(std::string_view text, const StoreIndexHeader& h,
+                              const std::vector<StoreIndexEntry>& entries) {
+    if (h.logBytes > text.size()) return false;
+    if (h.logBytes > 0 && h.logBytes < text.size() && text[h.logBytes - 1] != '\n') return false;
+    std::string_view log = text.substr(0, h.logBytes);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const StoreIndexEntry& e = entries[i];
+        if (e.length == 0) continue;  // ûù
+        if (e.offset + e.length > log.size() || (e.offset > 0 && log[e.offset - 1] != '\n')) return false;
+        size_t lineStart = e.offset > 1 ? log.rfind('\n', e.offset - 2) : std::string_view::npos;
+        lineStart = lineStart == std::string_view::npos ? 0 : lineStart + 1;
+        uint32_t id, bytes;
+        bool put;
+        std::string_view before = e.offset > 0 ? log.substr(lineStart, e.offset - 1 - lineStart) : std::string_view();
+        if (parseRecordHeader(trimLineEnd(before), id, put, bytes) && put) {
+            if (id != i || bytes != e.length) return false;
+            continue;
+        }
+        std::string_view first = log.substr(e.offset, log.find('\n', e.offset) - e.offset);  // npos ʱȡĩβ
+        size_t end = e.offset + e.length;
+        if (!isQuestionMarker(trimLineEnd(first)) || (log[end - 1] != '\n' && end + 1 < log.size())) return false;
+    }
+    return true;
+}
+
+// ȡЧ־ѱд־Բʱ falsecurrent ʾ־
+inline bool readStoreIndex(const std::string& filename, StoreIndexHeader& h, std::vector<StoreIndexEntry>& entries,
+                           bool& current) {
+    namespace fs = std::filesystem;
+    current = false;
+    if (!readStoreIndexHeader(filename, h, current)) return false;
+    std::ifstream in(storeIndexPath(filename), std::ios::binary);
+    entries.resize(h.count);
+    in.seekg(sizeof(StoreIndexHeader));
+    if (!in.read(reinterpret_cast<char*>(entries.data()),
+                 static_cast<std::streamsize>(entries.size() * sizeof(StoreIndexEntry)))) {
+        return false;
+    }
+    std::error_code ec;
+    if (!current && fs::file_size(filename, ec) == h.logBytes) return false;  // Ȳ䵫¹˵д
+    MappedFile file;
+    return file.open(filename) && storeIndexMatches(file.view(), h, entries);
+}
+
+inline bool writeStoreIndex(const std::string& filename, const StoreIndexHeader& h,
+                            const std::vector<StoreIndexEntry>& entries) {
+    std::ofstream out(storeIndexPath(filename), std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(StoreIndexEntry)));
+    return static_cast<bool>(out);
+}
+
+class BankStore {
+public:
+    BankStore() = default;
+    ~BankStore() { close(); }
+
+    BankStore(const BankStore&) = delete;
+    BankStore& operator=(const BankStore&) = delete;
+
+    // ⣻ļʱдģʽ½ȱʧʱɨ־ؽ
+    // дģʽ»ص־ĩβдһļ¼д
+    bool open(const std::string& filename, bool writable = true) {
+        namespace fs = std::filesystem;
+        close();
+        filename_ = filename;
+        indexPath_ = storeIndexPath(filename);
+        writable_ = writable;
+        std::error_code ec;
+        if (!fs::exists(filename, ec)) {
+            if (!writable) return false;
+            std::ofstream(filename, std::ios::binary);
+        }
+
+        bool current = false;
+        if (!readStoreIndex(filename, h_, entries_, current)) {
+            entries_.clear();
+            h_ = StoreIndexHeader();
+            memcpy(h_.magic, kStoreIndexMagic, 4);
+            h_.version = kStoreIndexVersion;
+        }
+
+        bool dirty = !current;
+        if (!current) {
+            MappedFile file;
+            if (!file.open(filename)) return false;
+            std::string_view text = file.view();
+            size_t end = scanStoreLog(text.substr(h_.logBytes), h_.logBytes, entries_, h_);
+            h_.logBytes += end;
+            if (writable && h_.logBytes < text.size()) {
+                file.close();
+                fs::resize_file(filename, h_.logBytes, ec);
+            }
+        }
+        if (writable && h_.logBytes > 0) {
+            // һûлзֹ༭ⳣʱϣ¼ͷܶռһ
+            std::ifstream in(filename, std::ios::binary);
+            in.seekg(static_cast<std::streamoff>(h_.logBytes - 1));
+            if (in.get() != '\n') {
+                in.close();
+                std::ofstream(filename, std::ios::binary | std::ios::app) << '\n';
+                ++h_.logBytes;
+                dirty = true;
+            }
+        }
+
+        if (writable) {
+            log_.open(filename, std::ios::binary | std::ios::app);
+            if (!log_ || (dirty && !saveIndex())) return false;
+            index_.open(indexPath_, std::ios::binary | std::ios::in | std::ios::out);
+            if (!index_) return false;
+        }
+        open_ = true;
+        return true;
+    }
+
+    // ȴ̨ѹرļ
+    void close() {
+        if (worker_.joinable()) worker_.join();
+        log_.close();
+        index_.close();
+        open_ = false;
+    }
+
+    bool isOpen() const { return open_; }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    size_t liveCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return h_.liveCount;
+    }
+
+    bool contains(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return id < entries_.size() && entries_[id].live;
+    }
+
+    // ȡһı#TYPE ... #ENDֻһζλͶȡ
+    bool read(uint32_t id, std::string& text) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (id >= entries_.size() || !entries_[id].live) return false;
+        std::ifstream in(filename_, std::ios::binary);
+        text.resize(entries_[id].length);
+        in.seekg(static_cast<std::streamoff>(entries_[id].offset));
+        return static_cast<bool>(in.read(&text[0], static_cast<std::streamsize>(text.size())));
+    }
+
+    // ˳ƴЧĿı
+    bool readLive(std::string& out) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        MappedFile file;
+        if (!file.open(filename_)) return false;
+        std::string_view text = file.view();
+        out.clear();
+        out.reserve(h_.liveBytes + h_.liveCount);
+        appendLiveRecords(text, entries_, out);
+        return true;
+    }
+
+    // ׷һ⣬ţʧܷ -1
+    long long append(std::string_view text) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t id = static_cast<uint32_t>(entries_.size());
+        return writePut(id, text) ? id : -1;
+    }
+
+    // µı滻һ
+    bool put(uint32_t id, std::string_view text) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (id >= entries_.size() || !entries_[id].live || !writePut(id, text)) return false;
+        }
+        maybeCompact();
+        return true;
+    }
+
+    bool remove(uint32_t id) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (id >= entries_.size() || !entries_[id].live) return false;
+            std::string header = "#RECORD " + std::to_string(id) + " DEL\n\n";
+            if (!writeLog(header)) return false;
+            applyStoreDelete(entries_, h_, id);
+            if (!writeEntry(id)) return false;
+        }
+        maybeCompact();
+        return true;
+    }
+
+    bool needsCompaction() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return h_.deadBytes >= kStoreCompactMinBytes && h_.deadBytes > h_.liveBytes;
+    }
+
+    uint64_t deadBytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return h_.deadBytes;
+    }
+
+    // ں̨߳ѹѹڽʱֱӷ
+    void compactInBackground() {
+        if (!writable_ || compacting_.exchange(true)) return;
+        if (worker_.joinable()) worker_.join();
+        worker_ = std::thread([this] {
+            compactNow();
+            compacting_ = false;
+        });
+    }
+
+    // ͬѹ˳дЧ¼¼ͷűֲ
+    bool compact() {
+        if (!writable_ || compacting_.exchange(true)) return false;
+        bool ok = compactNow();
+        compacting_ = false;
+        return ok;
+    }
+
+private:
+    bool writeLog(std::string_view data) {
+        log_.write(data.data(), static_cast<std::streamsize>(data.size()));
+        log_.flush();
+        if (!log_) return false;
+        h_.logBytes += data.size();
+        return true;
+    }
+
+    // дһ PUT ¼÷
+    bool writePut(uint32_t id, std::string_view text) {
+        std::string record = "#RECORD " + std::to_string(id) + " PUT " + std::to_string(text.size()) + "\n";
+        uint64_t offset = h_.logBytes + record.size();
+        record.append(text.data(), text.size());
+        record += '\n';
+        if (!writeLog(record)) return false;
+        applyStorePut(entries_, h_, id, offset, static_cast<uint32_t>(text.size()));
+        return writeEntry(id);
+    }
+
+    // ֻдеһļͷ
+    bool writeEntry(uint32_t id) {
+        index_.seekp(static_cast<std::streamoff>(sizeof(StoreIndexHeader) + uint64_t(id) * sizeof(StoreIndexEntry)));
+        index_.write(reinterpret_cast<const char*>(&entries_[id]), sizeof(StoreIndexEntry));
+        index_.seekp(0);
+        index_.write(reinterpret_cast<const char*>(&h_), sizeof(h_));
+        index_.flush();
+        return static_cast<bool>(index_);
+    }
+
+    // д÷δʼʣ
+    bool saveIndex() {
+        index_.close();
+        return writeStoreIndex(filename_, h_, entries_);
+    }
+
+    void maybeCompact() {
+        if (needsCompaction()) compactInBackground();
+    }
+
+    bool compactNow() {
+        namespace fs = std::filesystem;
+        // 1. µǰ֮д׷ӵ־
+        std::vector<StoreIndexEntry> entries;
+        StoreIndexHeader h;
+        uint64_t snapshotBytes;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries = entries_;
+            h = h_;
+            snapshotBytes = h_.logBytes;
+        }
+
+        // 2. Ч¼дʱļ
+        std::string tmp = filename_ + ".compact";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        h.liveCount = 0;
+        h.liveBytes = 0;
+        h.deadBytes = 0;
+        uint64_t written = 0;
+        {
+            MappedFile file;
+            if (!file.open(filename_)) return false;
+            std::string_view text = file.view();
+            std::string record;
+            for (uint32_t id = 0; id < entries.size(); ++id) {
+                StoreIndexEntry& e = entries[id];
+                if (!e.live || e.offset + e.length > snapshotBytes) {
+                    e = {0, 0, 0};
+                    continue;
+                }
+                record = "#RECORD " + std::to_string(id) + " PUT " + std::to_string(e.length) + "\n";
+                uint64_t offset = written + record.size();
+                record.append(text.data() + e.offset, e.length);
+                record += '\n';
+                out.write(record.data(), static_cast<std::streamsize>(record.size()));
+                written += record.size();
+                e.offset = offset;
+                h.liveBytes += e.length;
+                ++h.liveCount;
+            }
+        }
+
+        // 3. ѹڼ׷ӵļ¼滻־
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (h_.logBytes > snapshotBytes) {
+            std::string tail(h_.logBytes - snapshotBytes, '\0');
+            std::ifstream in(filename_, std::ios::binary);
+            in.seekg(static_cast<std::streamoff>(snapshotBytes));
+            in.read(&tail[0], static_cast<std::streamsize>(tail.size()));
+            out.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+            scanStoreLog(tail, written, entries, h);
+            written += tail.size();
+        }
+        out.close();
+        if (!out) return false;
+
+        log_.close();
+        std::error_code ec;
+        fs::rename(tmp, filename_, ec);
+        log_.open(filename_, std::ios::binary | std::ios::app);
+        if (ec) return false;
+        entries_ = std::move(entries);
+        h_ = h;
+        h_.count = static_cast<uint32_t>(entries_.size());
+        h_.logBytes = written;
+        bool ok = saveIndex();
+        index_.open(indexPath_, std::ios::binary | std::ios::in | std::ios::out);
+        return ok && static_cast<bool>(index_);
+    }
+
+    std::string filename_;
+    std::string indexPath_;
+    bool writable_ = false;
+    bool open_ = false;
+    std::vector<StoreIndexEntry> entries_;
+    StoreIndexHeader h_{};
+    std::ofstream log_;
+    std::fstream index_;
+    mutable std::mutex mutex_;
+    std::thread worker_;
+    std::atomic<bool> compacting_{false};
+};
+
+// ȡı⣺޸ĻɾĿ־ʧЧ¼ʱֻȡÿŵ°汾ֱӽ
+inline bool loadTextBank(const std::string& filename, QuestionBank& bank) {
+    StoreIndexHeader h;
+    bool current = false;
+    bool versioned;
+    if (readStoreIndexHeader(filename, h, current) && current) {
+        versioned = h.deadBytes > 0;
+    } else {
+        MappedFile file;
+        versioned = file.open(filename) && file.view().find("#RECORD ") != std::string_view::npos;
+    }
+    if (!versioned) return loadQuestions(filename, bank);
+
+    BankStore store;
+    std::string text;
+    if (!store.open(filename, false) || !store.readLive(text)) return loadQuestions(filename, bank);
+    bank.file.close();
+    bank.lines.clear();
+    bank.questions.clear();
+    bank.converted.clear();
+    if (detectEncoding(std::string_view(text).substr(0, kEncodingSampleBytes)) == TextEncoding::UTF8) {
+        utf8ToGbk(text, bank.converted);
+    } else {
+        bank.converted = std::move(text);
+    }
+    parseQuestions(bank.converted, bank);
+    return true;
+}
+
+// ڴеıϴ txt #RECORD ¼ʱ loadTextBank һֻÿŵ°汾
+//  storage У¼ʱֱӷ text
+inline std::string_view liveBankText(std::string_view text, std::string& storage) {
+    if (text.find("#RECORD ") == std::string_view::npos) return text;
+    std::vector<StoreIndexEntry> entries;
+    StoreIndexHeader h{};
+    scanStoreLog(text, 0, entries, h);
+    storage.clear();
+    storage.reserve(h.liveBytes + h.liveCount);
+    appendLiveRecords(text, entries, storage);
+    return storage;
+}
+
+#endif  // BANK_STORE_H
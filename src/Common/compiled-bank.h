@@ -0,0 +1,192 @@
+#ifndef COMPILED_BANK_H
+#define COMPILED_BANK_H
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "bank-store.h"
+#include "question-bank.h"
+
+// Ķ⣨.qbk obj-compile  .txt 
+//
+// ļ֣Сˣΰ 8 ֽڶ룩
+//   BankHeader
+//   BankRecord[questionCount]   ÿһ¼ƫƱ
+//   uint32_t[lineCount]         ÿַеı
+//   BankString[stringCount]     ȥغַƫ + ȣ
+//   char[poolBytes]             ַ
+const char kBankMagic[4] = {'Q', 'B', 'N', 'K'};
+const uint16_t kBankVersion = 1;
+
+// ͱż QuestionType öֵquestion-type.h
+
+struct BankHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t questionCount;
+    uint32_t lineCount;
+    uint32_t stringCount;
+    uint32_t poolBytes;
+    uint64_t recordsOffset;
+    uint64_t linesOffset;
+    uint64_t stringsOffset;
+    uint64_t poolOffset;
+};
+
+struct BankRecord {
+    uint32_t firstLine;      // ɵһбеλãѡͲο𰸽
+    uint32_t correctMask;    // ȷλͼ i λʾ i ѡ
+    uint16_t questionLines;
+    uint16_t optionLines;
+    uint16_t answerLines;
+    uint8_t type;
+    uint8_t reserved;
+};
+
+struct BankString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+//  xxx.txt  xxx.qbk
+inline std::string compiledBankPath(const std::string& filename) {
+    std::string path = filename;
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".txt") == 0) {
+        path.resize(path.size() - 4);
+    }
+    return path + ".qbk";
+}
+
+// ѽõдɶƸʽ false ʾдʧ
+inline bool writeCompiledBank(const QuestionBank& bank, const std::string& outPath) {
+    std::unordered_map<std::string_view, uint32_t> interned;
+    std::vector<BankString> strings;
+    std::string pool;
+    std::vector<uint32_t> lines;
+    std::vector<BankRecord> records;
+    records.reserve(bank.questions.size());
+
+    auto intern = [&](std::string_view s) {
+        auto it = interned.find(s);
+        if (it != interned.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(strings.size());
+        strings.push_back({static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(s.size())});
+        pool.append(s.data(), s.size());
+        interned.emplace(s, id);
+        return id;
+    };
+
+    for (const auto& q : bank.questions) {
+        BankRecord r{};
+        r.type = static_cast<uint8_t>(q.type);
+        r.firstLine = static_cast<uint32_t>(lines.size());
+        r.questionLines = static_cast<uint16_t>(q.question.size());
+        r.optionLines = static_cast<uint16_t>(q.options.size());
+        r.answerLines = static_cast<uint16_t>(q.answers.size());
+        for (const auto& line : q.question) lines.push_back(intern(line));
+        for (const auto& line : q.options) lines.push_back(intern(line));
+        for (const auto& line : q.answers) lines.push_back(intern(line));
+        r.correctMask = q.correctAnswers;
+        records.push_back(r);
+    }
+
+    auto align8 = [](uint64_t n) { return (n + 7) & ~uint64_t(7); };
+    BankHeader h{};
+    memcpy(h.magic, kBankMagic, 4);
+    h.version = kBankVersion;
+    h.questionCount = static_cast<uint32_t>(records.size());
+    h.lineCount = static_cast<uint32_t>(lines.size());
+    h.stringCount = static_cast<uint32_t>(strings.size());
+    h.poolBytes = static_cast<uint32_t>(pool.size());
+    h.recordsOffset = align8(sizeof(BankHeader));
+    h.linesOffset = align8(h.recordsOffset + records.size() * sizeof(BankRecord));
+    h.stringsOffset = align8(h.linesOffset + lines.size() * sizeof(uint32_t));
+    h.poolOffset = align8(h.stringsOffset + strings.size() * sizeof(BankString));
+
+    // ڴƴļһд
+    std::string out(h.poolOffset + pool.size(), '\0');
+    memcpy(&out[0], &h, sizeof(h));
+    if (!records.empty()) memcpy(&out[h.recordsOffset], records.data(), records.size() * sizeof(BankRecord));
+    if (!lines.empty()) memcpy(&out[h.linesOffset], lines.data(), lines.size() * sizeof(uint32_t));
+    if (!strings.empty()) memcpy(&out[h.stringsOffset], strings.data(), strings.size() * sizeof(BankString));
+    if (!pool.empty()) memcpy(&out[h.poolOffset], pool.data(), pool.size());
+
+    std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+// ֱӳ⣬ıʽʱ false
+inline bool loadCompiledBank(const std::string& path, QuestionBank& bank) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < sizeof(BankHeader)) return false;
+
+    const char* base = file.data();
+    BankHeader h;
+    memcpy(&h, base, sizeof(h));
+    if (memcmp(h.magic, kBankMagic, 4) != 0 || h.version != kBankVersion) return false;
+    if (h.recordsOffset + uint64_t(h.questionCount) * sizeof(BankRecord) > file.size() ||
+        h.linesOffset + uint64_t(h.lineCount) * sizeof(uint32_t) > file.size() ||
+        h.stringsOffset + uint64_t(h.stringCount) * sizeof(BankString) > file.size() ||
+        h.poolOffset + h.poolBytes > file.size()) {
+        return false;
+    }
+
+    const BankRecord* records = reinterpret_cast<const BankRecord*>(base + h.recordsOffset);
+    const uint32_t* lineIds = reinterpret_cast<const uint32_t*>(base + h.linesOffset);
+    const BankString* strings = reinterpret_cast<const BankString*>(base + h.stringsOffset);
+    const char* pool = base + h.poolOffset;
+
+    bank.lines.clear();
+    bank.questions.clear();
+    bank.lines.reserve(h.lineCount);
+    for (uint32_t i = 0; i < h.lineCount; ++i) {
+        if (lineIds[i] >= h.stringCount) return false;
+        const BankString& s = strings[lineIds[i]];
+        if (uint64_t(s.offset) + s.length > h.poolBytes) return false;
+        bank.lines.emplace_back(pool + s.offset, s.length);
+    }
+
+    const std::string_view* lines = bank.lines.data();
+    bank.questions.reserve(h.questionCount);
+    for (uint32_t i = 0; i < h.questionCount; ++i) {
+        const BankRecord& r = records[i];
+        if (r.type >= kQuestionTypeCount ||
+            uint64_t(r.firstLine) + r.questionLines + r.optionLines + r.answerLines > h.lineCount) {
+            return false;
+        }
+        Question q;
+        q.type = static_cast<QuestionType>(r.type);
+        q.question = {lines + r.firstLine, r.questionLines};
+        q.options = {q.question.end(), r.optionLines};
+        q.answers = {q.options.end(), r.answerLines};
+        q.correctAnswers = r.correctMask;
+        bank.questions.push_back(q);
+    }
+
+    bank.file = std::move(file);
+    return true;
+}
+
+// ȡ⣺ڲ .txt  .qbk ʱֱӼأ˵ıֻȡÿ°汾
+inline bool loadBank(const std::string& filename, QuestionBank& bank) {
+    namespace fs = std::filesystem;
+    std::string compiled = compiledBankPath(filename);
+    std::error_code ec;
+    if (fs::exists(compiled, ec)) {
+        bool stale = fs::exists(filename, ec) &&
+                     fs::last_write_time(filename, ec) > fs::last_write_time(compiled, ec);
+        if (!stale && loadCompiledBank(compiled, bank)) return true;
+    }
+    return loadTextBank(filename, bank);
+}
+
+#endif  // COMPILED_BANK_H
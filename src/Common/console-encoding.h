@@ -0,0 +1,137 @@
+#ifndef CONSOLE_ENCODING_H
+#define CONSOLE_ENCODING_H
+
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+#include "text-encoding.h"
+
+// ⡢ⱾͳеĶ GBK UTF-8 նˣLinux/macOS ĳãϣ
+// ConsoleEncoding  cout ת UTF-8Ѵ cin  UTF-8 ת GBK
+// ڲȻֻ GBKWindows ̨ GBKת
+
+//  LC_ALL / LC_CTYPE / LANGȡһǿյģжնǷʹ UTF-8
+inline bool utf8Terminal() {
+#ifdef _WIN32
+    return false;
+#else
+    for (const char* name : {"LC_ALL", "LC_CTYPE", "LANG"}) {
+        const char* value = std::getenv(name);
+        if (value == nullptr || *value == '\0') continue;
+        std::string v = value;
+        for (auto& c : v) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return v.find("utf-8") != std::string::npos || v.find("utf8") != std::string::npos;
+    }
+    return false;
+#endif
+}
+
+// ת룺壬ÿдת󽻸ԭĻ printf ˳򱣳һ
+class Utf8OutputBuf : public std::streambuf {
+public:
+    explicit Utf8OutputBuf(std::streambuf* dest) : dest_(dest) {}
+
+protected:
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        char ch = traits_type::to_char_type(c);
+        write(&ch, 1);
+        return c;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        write(s, static_cast<size_t>(n));
+        return n;
+    }
+
+    int sync() override { return dest_->pubsync(); }
+
+private:
+    void write(const char* s, size_t n) {
+        out_.clear();
+        conv_.feed(std::string_view(s, n), out_);
+        dest_->sputn(out_.data(), static_cast<std::streamsize>(out_.size()));
+    }
+
+    std::streambuf* dest_;
+    GbkToUtf8 conv_;
+    std::string out_;
+};
+
+// ת룺ÿδԭĻȡһУзת룬
+// ֱ֮ӵ getchar()  C ҲӰ
+class GbkInputBuf : public std::streambuf {
+public:
+    explicit GbkInputBuf(std::streambuf* src) : src_(src) {}
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+        buffer_.clear();
+        while (buffer_.empty()) {
+            line_.clear();
+            bool eof = false;
+            for (;;) {
+                int_type c = src_->sbumpc();
+                if (traits_type::eq_int_type(c, traits_type::eof())) {
+                    eof = true;
+                    break;
+                }
+                line_ += traits_type::to_char_type(c);
+                if (c == '\n') break;
+            }
+            conv_.feed(line_, buffer_);
+            if (eof) {
+                conv_.finish(buffer_);
+                if (buffer_.empty()) return traits_type::eof();
+            }
+        }
+        setg(&buffer_[0], &buffer_[0], &buffer_[0] + buffer_.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    std::streambuf* src_;
+    Utf8ToGbk conv_;
+    std::string line_;
+    std::string buffer_;
+};
+
+//  main ͷ cin/cout/cerr ն˱ת룬ʱָ
+class ConsoleEncoding {
+public:
+    ConsoleEncoding() {
+        if (!utf8Terminal()) return;
+        out_ = std::make_unique<Utf8OutputBuf>(std::cout.rdbuf());
+        err_ = std::make_unique<Utf8OutputBuf>(std::cerr.rdbuf());
+        in_ = std::make_unique<GbkInputBuf>(std::cin.rdbuf());
+        oldOut_ = std::cout.rdbuf(out_.get());
+        oldErr_ = std::cerr.rdbuf(err_.get());
+        oldIn_ = std::cin.rdbuf(in_.get());
+    }
+
+    ~ConsoleEncoding() {
+        if (!out_) return;
+        std::cout.flush();
+        std::cout.rdbuf(oldOut_);
+        std::cerr.rdbuf(oldErr_);
+        std::cin.rdbuf(oldIn_);
+    }
+
+    ConsoleEncoding(const ConsoleEncoding&) = delete;
+    ConsoleEncoding& operator=(const ConsoleEncoding&) = delete;
+
+private:
+    std::unique_ptr<Utf8OutputBuf> out_, err_;
+    std::unique_ptr<GbkInputBuf> in_;
+    std::streambuf* oldOut_ = nullptr;
+    std::streambuf* oldErr_ = nullptr;
+    std::streambuf* oldIn_ = nullptr;
+};
+
+#endif  // CONSOLE_ENCODING_H
@@ -0,0 +1,114 @@
+#ifndef DEDUP_INDEX_H
+#define DEDUP_INDEX_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "question-bank.h"
+
+// 64 λ FNV-1aֽۼ
+const uint64_t kFnvOffset = 1469598103934665603ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+
+inline uint64_t mix64(uint64_t x) {  // splitmix64 ջ캯
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// 淶ۼӹϣȥ ASCII հסASCII ĸתСд
+// λá"( )"  "()" ֮ĲӰ
+inline uint64_t hashNormalized(std::string_view text, uint64_t h = kFnvOffset) {
+    for (unsigned char c : text) {
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') continue;
+        if (c >= 'A' && c <= 'Z') c = static_cast<unsigned char>(c - 'A' + 'a');
+        h = (h ^ c) * kFnvPrime;
+    }
+    return h;
+}
+
+// Ŀָƣ +  + ѡ + ȷѡݣΪο𰸣
+// ѡϴѡ˳򱻴ҵͬһָͬ
+inline uint64_t questionFingerprint(const Question& q) {
+    uint64_t stem = hashNormalized(questionTypeName(q.type));
+    for (const auto& line : q.question) stem = hashNormalized(line, stem);
+
+    uint64_t options = 0, correct = 0;
+    for (size_t i = 0; i < q.options.size(); ++i) {
+        options += mix64(hashNormalized(q.options[i]));
+    }
+    for (uint32_t m = q.correctAnswers; m; m &= m - 1) {
+        int idx = lowestBit(m);
+        if (idx < static_cast<int>(q.options.size())) correct += mix64(hashNormalized(q.options[idx]) ^ 1);
+    }
+    uint64_t answers = kFnvOffset;
+    for (const auto& line : q.answers) answers = hashNormalized(line, answers);
+
+    uint64_t fp = mix64(stem);
+    fp = mix64(fp ^ options);
+    fp = mix64(fp ^ correct);
+    fp = mix64(fp ^ answers);
+    return fp == 0 ? 1 : fp;  // 0 ϣʾղ
+}
+
+// Ѱַ̽⣩ָƱָ -> Ŀ±
+class FingerprintIndex {
+public:
+    explicit FingerprintIndex(size_t expected = 0) { rehash(capacityFor(expected)); }
+
+    // ָƣѴʱԭ±꣬¼ value  -1
+    long long insert(uint64_t fp, uint32_t value) {
+        if ((size_ + 1) * 2 > keys_.size()) rehash(keys_.size() * 2);
+        size_t i = fp & mask_;
+        while (keys_[i] != 0) {
+            if (keys_[i] == fp) return values_[i];
+            i = (i + 1) & mask_;
+        }
+        keys_[i] = fp;
+        values_[i] = value;
+        ++size_;
+        return -1;
+    }
+
+    // ָƶӦ±꣬ʱ -1
+    long long find(uint64_t fp) const {
+        for (size_t i = fp & mask_; keys_[i] != 0; i = (i + 1) & mask_) {
+            if (keys_[i] == fp) return values_[i];
+        }
+        return -1;
+    }
+
+    bool contains(uint64_t fp) const { return find(fp) >= 0; }
+
+    size_t size() const { return size_; }
+
+private:
+    static size_t capacityFor(size_t expected) {
+        size_t cap = 16;
+        while (cap < expected * 2) cap <<= 1;
+        return cap;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<uint64_t> oldKeys(capacity, 0);
+        std::vector<uint32_t> oldValues(capacity, 0);
+        oldKeys.swap(keys_);
+        oldValues.swap(values_);
+        mask_ = capacity - 1;
+        size_ = 0;
+        for (size_t i = 0; i < oldKeys.size(); ++i) {
+            if (oldKeys[i] != 0) insert(oldKeys[i], oldValues[i]);
+        }
+    }
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> values_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+};
+
+#endif  // DEDUP_INDEX_H
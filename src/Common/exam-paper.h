@@ -0,0 +1,141 @@
+#ifndef EXAM_PAPER_H
+#define EXAM_PAPER_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped-file.h"
+#include "question-bank.h"
+#include "question-type.h"
+
+// Ծ𰸣.keyobj-paper ΪÿԾдһobj-quiz --batch --key ԾĴ⿨з֡
+// ļһ "#KEY seed=<> variant=<ڼ> questions=<>"֮ÿһУ
+//   ,,Ŀָ(16 λʮ),ѡ˳,
+// ѡ˳Ǹʾλϵԭʼѡţ 0 ʼոָԾʾıţѡöŷָһУ
+// зʱָһеĿ⿨ϵıžѡ˳򻻻ԭʼźȷ𰸱Ƚ
+
+const uint32_t kUnresolvedQuestion = UINT32_MAX;
+
+struct PaperItem {
+    uint32_t question = kUnresolvedQuestion;  // е±꣬ȡ .key ָ
+    QuestionType type = QuestionType::JUDGE;
+    uint64_t fingerprint = 0;
+    std::vector<int> order;  // order[k] Ϊʾڵ k λõԭʼѡ
+};
+
+struct ExamPaper {
+    uint64_t seed = 0;
+    size_t variant = 0;  //  1 ʼ
+    std::vector<PaperItem> items;
+};
+
+//  variant ԾӣӾ splitmix64 ֮以أĳһʱͬ
+inline uint64_t paperSeed(uint64_t seed, size_t variant) {
+    uint64_t z = seed ^ (0xD1B54A32D192ED03ull * (variant + 1));
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// ѡԾϵıţжΪ 1/2Ϊ A/B/C...
+inline void appendOptionLabel(std::string& out, QuestionType type, size_t position) {
+    if (questionTypeInfo(type).numberedOptions) {
+        out += std::to_string(position + 1);
+    } else {
+        out += static_cast<char>(position < 26 ? 'A' + position : '?');
+    }
+}
+
+inline void appendPaperKey(std::string& out, const ExamPaper& paper, const std::vector<Question>& questions) {
+    char buf[96];
+    snprintf(buf, sizeof(buf), "#KEY seed=%llu variant=%zu questions=%zu\n",
+             static_cast<unsigned long long>(paper.seed), paper.variant, paper.items.size());
+    out += buf;
+    for (size_t i = 0; i < paper.items.size(); ++i) {
+        const PaperItem& item = paper.items[i];
+        snprintf(buf, sizeof(buf), "%zu,", i + 1);
+        out += buf;
+        out += questionTypeName(item.type);
+        snprintf(buf, sizeof(buf), ",%016llx,", static_cast<unsigned long long>(item.fingerprint));
+        out += buf;
+        for (size_t k = 0; k < item.order.size(); ++k) {
+            if (k) out += ' ';
+            out += std::to_string(item.order[k]);
+        }
+        out += ',';
+        uint32_t correct = questions[item.question].correctAnswers;
+        bool first = true;
+        for (size_t k = 0; k < item.order.size(); ++k) {
+            if (item.order[k] >= 32 || !(correct >> item.order[k] & 1)) continue;
+            if (!first) out += ',';
+            appendOptionLabel(out, item.type, k);
+            first = false;
+        }
+        out += '\n';
+    }
+}
+
+// ȡ .keyʽʱ false  error ˵ڼУ
+inline bool loadPaperKey(const std::string& path, ExamPaper& paper, std::string& error) {
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "unable to read";
+        return false;
+    }
+    paper = ExamPaper();
+    std::string_view text = file.view();
+    size_t lineNo = 0;
+    while (!text.empty()) {
+        size_t nl = text.find('\n');
+        std::string_view line = text.substr(0, nl);
+        text = (nl == std::string_view::npos) ? std::string_view() : text.substr(nl + 1);
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+        if (line[0] == '#') {
+            size_t pos = line.find("seed=");
+            if (pos != std::string_view::npos) {
+                std::from_chars(line.data() + pos + 5, line.data() + line.size(), paper.seed);
+            }
+            pos = line.find("variant=");
+            if (pos != std::string_view::npos) {
+                std::from_chars(line.data() + pos + 8, line.data() + line.size(), paper.variant);
+            }
+            continue;
+        }
+
+        // ǰԶŷָбܺţҪȡ
+        std::string_view fields[4];
+        for (auto& field : fields) {
+            size_t comma = line.find(',');
+            field = line.substr(0, comma);
+            line = (comma == std::string_view::npos) ? std::string_view() : line.substr(comma + 1);
+        }
+        PaperItem item;
+        size_t number = 0;
+        auto res = std::from_chars(fields[0].data(), fields[0].data() + fields[0].size(), number);
+        bool ok = res.ec == std::errc() && number == paper.items.size() + 1 && parseQuestionType(fields[1], item.type);
+        ok = ok && std::from_chars(fields[2].data(), fields[2].data() + fields[2].size(), item.fingerprint, 16).ec ==
+                       std::errc();
+        for (std::string_view order = fields[3]; ok && !order.empty();) {
+            size_t space = order.find(' ');
+            std::string_view token = order.substr(0, space);
+            order = (space == std::string_view::npos) ? std::string_view() : order.substr(space + 1);
+            int idx = 0;
+            ok = std::from_chars(token.data(), token.data() + token.size(), idx).ec == std::errc() && idx >= 0;
+            item.order.push_back(idx);
+        }
+        if (!ok) {
+            error = "invalid line " + std::to_string(lineNo);
+            return false;
+        }
+        paper.items.push_back(std::move(item));
+    }
+    return true;
+}
+
+#endif  // EXAM_PAPER_H
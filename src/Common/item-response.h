@@ -0,0 +1,324 @@
+#ifndef ITEM_RESPONSE_H
+#define ITEM_RESPONSE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "thread-pool.h"
+
+// ĿѶУ׼ĿӦۣ2PL ģͣΪ  ѧĿ j ĸ
+//   P = 1 / (1 + exp(-a_j ( - b_j)))b_j ΪѶȣԸΪ 50% ʱa_j Ϊֶ
+// ĳ߶Ϊֵ 0׼ 1ñ߼Ȼ EMBock-Aitkinƣ
+//   ȡ [-4, 4]  24 ڵɢ̬飻
+//   E ѧУÿѧڸڵϵĺ飻
+//   M ĿУÿһ Fisher scoring Ȼ EMÿһlog a  b ̬飬
+//   ٵĿֵӽ飬ΪֶȹƵúСʹѶȷɢ
+// ϡѧĿͬʱѧE ȡͰĿM ȡţҪ
+// ڲѭǶԸڵͬ㣬ڵȡ 4 ı-O2 ²Ҫ
+// ʱͺ floatE M ȡ루ʱڴƣ
+
+const size_t kAbilityNodes = 24;
+
+struct AbilityGrid {
+    double x[kAbilityNodes];
+    double logPrior[kAbilityNodes];  // ׼̬һȡ
+};
+
+inline const AbilityGrid& abilityGrid() {
+    static const AbilityGrid grid = [] {
+        AbilityGrid g;
+        double sum = 0;
+        for (size_t q = 0; q < kAbilityNodes; ++q) {
+            g.x[q] = -4.0 + 8.0 * q / (kAbilityNodes - 1);
+            sum += std::exp(-0.5 * g.x[q] * g.x[q]);
+        }
+        for (size_t q = 0; q < kAbilityNodes; ++q) g.logPrior[q] = -0.5 * g.x[q] * g.x[q] - std::log(sum);
+        return g;
+    }();
+    return grid;
+}
+
+struct ItemParameters {
+    double a = 1;  // ֶ
+    double b = 0;  // Ѷ
+};
+
+// һѧšĿšǷ
+struct Attempt {
+    uint32_t learner;
+    uint32_t item;
+    bool correct;
+};
+
+// ϡѧĿͬһѧͬһĶϲΪ, Դ
+struct ResponseMatrix {
+    size_t learners = 0, items = 0;
+    std::vector<uint32_t> learnerStart, learnerItem, learnerTries, learnerCorrect;  // ѧ
+    std::vector<uint32_t> itemStart, itemLearner, itemTries, itemCorrect;           // Ŀ
+};
+
+inline ResponseMatrix buildResponseMatrix(size_t learners, size_t items, const std::vector<Attempt>& attempts) {
+    ResponseMatrix m;
+    m.learners = learners;
+    m.items = items;
+    // ѧĿԴһͬѧ, Ŀ
+    std::vector<uint64_t> keys(attempts.size());
+    for (size_t i = 0; i < attempts.size(); ++i) {
+        keys[i] = (uint64_t(attempts[i].learner) << 33) | (uint64_t(attempts[i].item) << 1) | attempts[i].correct;
+    }
+    std::sort(keys.begin(), keys.end());
+    m.learnerStart.assign(learners + 1, 0);
+    for (size_t i = 0; i < keys.size();) {
+        uint64_t cell = keys[i] >> 1;
+        uint32_t tries = 0, correct = 0;
+        for (; i < keys.size() && (keys[i] >> 1) == cell; ++i) {
+            ++tries;
+            correct += keys[i] & 1;
+        }
+        m.learnerStart[(cell >> 32) + 1]++;
+        m.learnerItem.push_back(static_cast<uint32_t>(cell));
+        m.learnerTries.push_back(tries);
+        m.learnerCorrect.push_back(correct);
+    }
+    for (size_t l = 0; l < learners; ++l) m.learnerStart[l + 1] += m.learnerStart[l];
+
+    // Ŀĸ
+    size_t cells = m.learnerItem.size();
+    m.itemStart.assign(items + 1, 0);
+    for (uint32_t j : m.learnerItem) m.itemStart[j + 1]++;
+    for (size_t j = 0; j < items; ++j) m.itemStart[j + 1] += m.itemStart[j];
+    m.itemLearner.resize(cells);
+    m.itemTries.resize(cells);
+    m.itemCorrect.resize(cells);
+    std::vector<uint32_t> next(m.itemStart.begin(), m.itemStart.end() - 1);
+    for (size_t l = 0; l < learners; ++l) {
+        for (uint32_t k = m.learnerStart[l]; k < m.learnerStart[l + 1]; ++k) {
+            uint32_t pos = next[m.learnerItem[k]]++;
+            m.itemLearner[pos] = static_cast<uint32_t>(l);
+            m.itemTries[pos] = m.learnerTries[k];
+            m.itemCorrect[pos] = m.learnerCorrect[k];
+        }
+    }
+    return m;
+}
+
+struct CalibrationOptions {
+    size_t maxIterations = 200;
+    double tolerance = 5e-3;     // log ab仯СڴֵʱֹͣԶСڼʮѶȵı׼Լ 0.3
+    double logSlopeSd = 0.5;     // ֶ飺log a ~ N(0, logSlopeSd^2)
+    double difficultySd = 2.0;   // Ѷ飺b ~ N(0, difficultySd^2)
+};
+
+struct Calibration {
+    std::vector<ItemParameters> items;
+    std::vector<double> ability, abilitySe;  // ѧĺֵͱ׼
+    size_t iterations = 0;
+    bool converged = false;
+    double logLikelihood = 0;  // ߼ʶȻ
+};
+
+//  [0, n) ֳÿ block ±겢дfn(i) 
+template <typename F>
+void parallelBlocks(size_t n, size_t block, F&& fn) {
+    parallelFor((n + block - 1) / block, [&](size_t b) {
+        size_t end = std::min(n, (b + 1) * block);
+        for (size_t i = b * block; i < end; ++i) fn(i);
+    });
+}
+
+inline Calibration calibrate(const ResponseMatrix& m, const CalibrationOptions& opt = CalibrationOptions()) {
+    const AbilityGrid& g = abilityGrid();
+    const size_t Q = kAbilityNodes;
+    std::vector<double> logSlope(m.items, 0.0), difficulty(m.items, 0.0), change(m.items);
+    std::vector<float> logP(m.items * Q), logQ(m.items * Q);  // ڸڵϴ/Ķ
+    std::vector<float> posterior(m.learners * Q);
+    std::vector<double> learnerLl(m.learners);
+    Calibration result;
+
+    for (result.iterations = 1; result.iterations <= opt.maxIterations; ++result.iterations) {
+        parallelBlocks(m.items, 256, [&](size_t j) {
+            for (size_t q = 0; q < Q; ++q) {
+                double z = std::exp(logSlope[j]) * (g.x[q] - difficulty[j]);
+                // log (z)  log (-z)߶
+                double t = std::log1p(std::exp(-std::fabs(z)));
+                logP[j * Q + q] = std::min(z, 0.0) - t;
+                logQ[j * Q + q] = std::min(-z, 0.0) - t;
+            }
+        });
+
+        // E ÿѧ
+        parallelBlocks(m.learners, 64, [&](size_t l) {
+            float lp[kAbilityNodes];
+            std::copy(g.logPrior, g.logPrior + Q, lp);
+            for (uint32_t k = m.learnerStart[l]; k < m.learnerStart[l + 1]; ++k) {
+                const float* p = &logP[m.learnerItem[k] * Q];
+                const float* f = &logQ[m.learnerItem[k] * Q];
+                float right = m.learnerCorrect[k], wrong = float(m.learnerTries[k]) - m.learnerCorrect[k];
+                for (size_t q = 0; q < Q; ++q) lp[q] += right * p[q] + wrong * f[q];
+            }
+            float top = *std::max_element(lp, lp + Q), sum = 0;
+            for (size_t q = 0; q < Q; ++q) sum += lp[q] = std::exp(lp[q] - top);
+            for (size_t q = 0; q < Q; ++q) posterior[l * Q + q] = lp[q] / sum;
+            learnerLl[l] = top + std::log(sum);
+        });
+
+        // M ÿڸڵϵ n_q ʹԴ r_qٶ (log a, b) һ Fisher scoring
+        double slopePrecision = 1 / (opt.logSlopeSd * opt.logSlopeSd);
+        double difficultyPrecision = 1 / (opt.difficultySd * opt.difficultySd);
+        parallelBlocks(m.items, 64, [&](size_t j) {
+            double r[kAbilityNodes] = {}, n[kAbilityNodes] = {};
+            for (uint32_t k = m.itemStart[j]; k < m.itemStart[j + 1]; ++k) {
+                const float* w = &posterior[m.itemLearner[k] * Q];
+                double tries = m.itemTries[k], correct = m.itemCorrect[k];
+                for (size_t q = 0; q < Q; ++q) {
+                    r[q] += correct * w[q];
+                    n[q] += tries * w[q];
+                }
+            }
+            double alpha = logSlope[j], b = difficulty[j], a = std::exp(alpha);
+            // z = a (x - b)dz/d = a (x - b)dz/db = -a
+            double ga = -alpha * slopePrecision, gb = -b * difficultyPrecision;
+            double iaa = slopePrecision, ibb = difficultyPrecision, iab = 0;
+            for (size_t q = 0; q < Q; ++q) {
+                double d = a * (g.x[q] - b);
+                double p = 1 / (1 + std::exp(-d));
+                double resid = r[q] - n[q] * p, info = n[q] * p * (1 - p);
+                ga += resid * d;
+                gb -= resid * a;
+                iaa += info * d * d;
+                iab -= info * d * a;
+                ibb += info * a * a;
+            }
+            double det = iaa * ibb - iab * iab;  // Ϣ
+            double da = (ibb * ga - iab * gb) / det, db = (iaa * gb - iab * ga) / det;
+            double scale = std::max({1.0, std::fabs(da), std::fabs(db)});  // ÿƶ 1
+            alpha = std::clamp(alpha + da / scale, -3.0, 2.0);
+            b = std::clamp(b + db / scale, -6.0, 6.0);
+            change[j] = std::max(std::fabs(alpha - logSlope[j]), std::fabs(b - difficulty[j]));
+            logSlope[j] = alpha;
+            difficulty[j] = b;
+        });
+
+        result.logLikelihood = 0;
+        for (double ll : learnerLl) result.logLikelihood += ll;
+        double maxChange = m.items ? *std::max_element(change.begin(), change.end()) : 0;
+        if (maxChange < opt.tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+    result.iterations = std::min(result.iterations, opt.maxIterations);
+
+    result.items.resize(m.items);
+    for (size_t j = 0; j < m.items; ++j) result.items[j] = {std::exp(logSlope[j]), difficulty[j]};
+    // һ E ĺֵͱ׼M ֻ˺٣㣩
+    result.ability.resize(m.learners);
+    result.abilitySe.resize(m.learners);
+    for (size_t l = 0; l < m.learners; ++l) {
+        double mean = 0, var = 0;
+        for (size_t q = 0; q < Q; ++q) mean += posterior[l * Q + q] * g.x[q];
+        for (size_t q = 0; q < Q; ++q) var += posterior[l * Q + q] * (g.x[q] - mean) * (g.x[q] - mean);
+        result.ability[l] = mean;
+        result.abilitySe[l] = std::sqrt(var);
+    }
+    return result;
+}
+
+// ӦеƣͬĽڵά飬ÿһϸȻ
+class AbilityTracker {
+public:
+    AbilityTracker() {
+        const AbilityGrid& g = abilityGrid();
+        for (size_t q = 0; q < kAbilityNodes; ++q) w_[q] = std::exp(g.logPrior[q]);
+    }
+
+    void update(const ItemParameters& item, bool correct) {
+        const AbilityGrid& g = abilityGrid();
+        double sum = 0;
+        for (size_t q = 0; q < kAbilityNodes; ++q) {
+            double p = probability(item, g.x[q]);
+            sum += w_[q] *= correct ? p : 1 - p;
+        }
+        for (double& w : w_) w /= sum;
+    }
+
+    double mean() const {
+        const AbilityGrid& g = abilityGrid();
+        double mean = 0;
+        for (size_t q = 0; q < kAbilityNodes; ++q) mean += w_[q] * g.x[q];
+        return mean;
+    }
+
+    double se() const {
+        const AbilityGrid& g = abilityGrid();
+        double m = mean(), var = 0;
+        for (size_t q = 0; q < kAbilityNodes; ++q) var += w_[q] * (g.x[q] - m) * (g.x[q] - m);
+        return std::sqrt(var);
+    }
+
+    // ǰȡ Fisher Ϣ  w_q a^2 P_q (1 - P_q)һѡֵ
+    double expectedInformation(const ItemParameters& item) const {
+        const AbilityGrid& g = abilityGrid();
+        double info = 0;
+        for (size_t q = 0; q < kAbilityNodes; ++q) {
+            double p = probability(item, g.x[q]);
+            info += w_[q] * p * (1 - p);
+        }
+        return info * item.a * item.a;
+    }
+
+    static double probability(const ItemParameters& item, double ability) {
+        return 1 / (1 + std::exp(-item.a * (ability - item.b)));
+    }
+
+private:
+    double w_[kAbilityNodes];
+};
+
+// У׼ļһ "#CALIBRATION model=2PL learners=<ѧ> attempts=<>"
+// ֮ÿһ "ָ(16 λʮ) ֶ Ѷ  Դ"ָƶӦĿĶȻЧ
+struct ItemCalibration {
+    ItemParameters params;
+    uint32_t tries = 0, correct = 0;
+};
+
+inline bool writeCalibration(const std::string& path, const std::vector<uint64_t>& fingerprints,
+                             const std::vector<ItemCalibration>& items, size_t learners, size_t attempts) {
+    std::string text;
+    char buf[128];
+    snprintf(buf, sizeof(buf), "#CALIBRATION model=2PL learners=%zu attempts=%zu\n", learners, attempts);
+    text += buf;
+    for (size_t j = 0; j < items.size(); ++j) {
+        snprintf(buf, sizeof(buf), "%016llx %.4f %.4f %u %u\n", static_cast<unsigned long long>(fingerprints[j]),
+                 items[j].params.a, items[j].params.b, items[j].tries, items[j].correct);
+        text += buf;
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(text.data(), text.size());
+    out.close();
+    return static_cast<bool>(out);
+}
+
+inline bool loadCalibration(const std::string& path, std::unordered_map<uint64_t, ItemCalibration>& items) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        unsigned long long fp = 0;
+        ItemCalibration item;
+        if (sscanf(line.c_str(), "%llx %lf %lf %u %u", &fp, &item.params.a, &item.params.b, &item.tries,
+                   &item.correct) >= 3) {
+            items[fp] = item;
+        }
+    }
+    return true;
+}
+
+#endif  // ITEM_RESPONSE_H
@@ -0,0 +1,384 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "text-encoding.h"
+
+// С JSON дֻݺͽӿõĲ֣顢ַ֡null
+// ַ UTF-8 ԭ棬\uXXXX ת UTF-8ԭʼ˳
+
+struct JsonValue {
+    enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+    bool boolean = false;
+    double number = 0;
+    std::string str;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    bool isString() const { return type == STRING; }
+    bool isArray() const { return type == ARRAY; }
+    bool isObject() const { return type == OBJECT; }
+    bool isInteger() const { return type == NUMBER && std::floor(number) == number && std::isfinite(number); }
+
+    // ҶԱʱ nullptr
+    const JsonValue* find(std::string_view key) const {
+        for (const auto& m : members) {
+            if (m.first == key) return &m.second;
+        }
+        return nullptr;
+    }
+
+    void set(std::string key, JsonValue value) {
+        for (auto& m : members) {
+            if (m.first == key) {
+                m.second = std::move(value);
+                return;
+            }
+        }
+        members.emplace_back(std::move(key), std::move(value));
+    }
+
+    static JsonValue makeString(std::string s) {
+        JsonValue v;
+        v.type = STRING;
+        v.str = std::move(s);
+        return v;
+    }
+
+    static JsonValue makeNumber(double n) {
+        JsonValue v;
+        v.type = NUMBER;
+        v.number = n;
+        return v;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view text) : s_(text) {}
+
+    bool parse(JsonValue& out) {
+        skipSpace();
+        if (!parseValue(out, 0)) return false;
+        skipSpace();
+        return pos_ == s_.size();
+    }
+
+private:
+    static constexpr int kMaxDepth = 64;
+
+    void skipSpace() {
+        while (pos_ < s_.size() && (s_[pos_] == ' ' || s_[pos_] == '\t' || s_[pos_] == '\n' || s_[pos_] == '\r')) ++pos_;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos_ < s_.size() && s_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool literal(std::string_view word) {
+        if (s_.substr(pos_, word.size()) != word) return false;
+        pos_ += word.size();
+        return true;
+    }
+
+    bool parseValue(JsonValue& v, int depth) {
+        if (depth > kMaxDepth) return false;
+        skipSpace();
+        if (pos_ >= s_.size()) return false;
+        char c = s_[pos_];
+        if (c == '{') {
+            ++pos_;
+            v.type = JsonValue::OBJECT;
+            if (consume('}')) return true;
+            do {
+                skipSpace();
+                std::string key;
+                if (!parseString(key) || !consume(':')) return false;
+                JsonValue member;
+                if (!parseValue(member, depth + 1)) return false;
+                v.members.emplace_back(std::move(key), std::move(member));
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[') {
+            ++pos_;
+            v.type = JsonValue::ARRAY;
+            if (consume(']')) return true;
+            do {
+                JsonValue item;
+                if (!parseValue(item, depth + 1)) return false;
+                v.items.push_back(std::move(item));
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            v.type = JsonValue::STRING;
+            return parseString(v.str);
+        }
+        if (c == 't' || c == 'f') {
+            v.type = JsonValue::BOOL;
+            v.boolean = c == 't';
+            return literal(c == 't' ? "true" : "false");
+        }
+        if (c == 'n') {
+            v.type = JsonValue::NUL;
+            return literal("null");
+        }
+        return parseNumber(v);
+    }
+
+    bool parseNumber(JsonValue& v) {
+        size_t start = pos_;
+        if (pos_ < s_.size() && s_[pos_] == '-') ++pos_;
+        while (pos_ < s_.size() && ((s_[pos_] >= '0' && s_[pos_] <= '9') || s_[pos_] == '.' || s_[pos_] == 'e' ||
+                                    s_[pos_] == 'E' || s_[pos_] == '+' || s_[pos_] == '-')) {
+            ++pos_;
+        }
+        if (pos_ == start) return false;
+        std::string text(s_.substr(start, pos_ - start));
+        char* end = nullptr;
+        v.type = JsonValue::NUMBER;
+        v.number = std::strtod(text.c_str(), &end);
+        return end == text.c_str() + text.size();
+    }
+
+    bool parseHex4(uint32_t& cp) {
+        if (pos_ + 4 > s_.size()) return false;
+        cp = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = s_[pos_++];
+            cp <<= 4;
+            if (c >= '0' && c <= '9') cp |= c - '0';
+            else if (c >= 'a' && c <= 'f') cp |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') cp |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        if (pos_ >= s_.size() || s_[pos_] != '"') return false;
+        ++pos_;
+        while (pos_ < s_.size()) {
+            char c = s_[pos_++];
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos_ >= s_.size()) return false;
+            char e = s_[pos_++];
+            switch (e) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!parseHex4(cp)) return false;
+                    // 
+                    if (cp >= 0xD800 && cp <= 0xDBFF && s_.substr(pos_, 2) == "\\u") {
+                        pos_ += 2;
+                        uint32_t low;
+                        if (!parseHex4(low)) return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendCodePoint(out, cp);
+                    break;
+                }
+                default: return false;
+            }
+        }
+        return false;
+    }
+
+    static void appendCodePoint(std::string& out, uint32_t cp) {
+        char buf[4];
+        out.append(buf, writeUtf8(buf, cp) - buf);
+    }
+
+    std::string_view s_;
+    size_t pos_ = 0;
+};
+
+inline bool parseJson(std::string_view text, JsonValue& out) {
+    out = JsonValue();
+    return JsonParser(text).parse(out);
+}
+
+// дźת JSON ַ ASCII ַԭҪתֽθ
+inline void appendJsonString(std::string& out, std::string_view s) {
+    out += '"';
+    size_t run = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        out.append(s.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default: {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            }
+        }
+    }
+    out.append(s.data() + run, s.size() - run);
+    out += '"';
+}
+
+// indent Ϊ 0 ʱոʽ JSON.stringify(v) ͬ
+inline void appendJson(std::string& out, const JsonValue& v, int indent = 0, int level = 0) {
+    auto newline = [&](int lv) {
+        if (indent == 0) return;
+        out += '\n';
+        out.append(static_cast<size_t>(indent * lv), ' ');
+    };
+    switch (v.type) {
+        case JsonValue::NUL: out += "null"; break;
+        case JsonValue::BOOL: out += v.boolean ? "true" : "false"; break;
+        case JsonValue::NUMBER: {
+            char buf[32];
+            if (v.isInteger() && std::fabs(v.number) < 1e15) snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(v.number));
+            else snprintf(buf, sizeof(buf), "%.17g", v.number);
+            out += buf;
+            break;
+        }
+        case JsonValue::STRING: appendJsonString(out, v.str); break;
+        case JsonValue::ARRAY:
+            out += '[';
+            for (size_t i = 0; i < v.items.size(); ++i) {
+                if (i > 0) out += ',';
+                newline(level + 1);
+                appendJson(out, v.items[i], indent, level + 1);
+            }
+            if (!v.items.empty()) newline(level);
+            out += ']';
+            break;
+        case JsonValue::OBJECT:
+            out += '{';
+            for (size_t i = 0; i < v.members.size(); ++i) {
+                if (i > 0) out += ',';
+                newline(level + 1);
+                appendJsonString(out, v.members[i].first);
+                out += indent == 0 ? ":" : ": ";
+                appendJson(out, v.members[i].second, indent, level + 1);
+            }
+            if (!v.members.empty()) newline(level);
+            out += '}';
+            break;
+    }
+}
+
+inline std::string toJson(const JsonValue& v, int indent = 0) {
+    std::string out;
+    appendJson(out, v, indent);
+    return out;
+}
+
+// ʽд JsonValueֱ׷ӵߵĻʽ appendJson ͬ
+// Ƕ״̬ JsonWriter У߿ʱѻдļգд
+// depth  0 ʱӵ depth ĿͷдԪأ̸߳дһΣ
+// ƴʱڷǿյĶ֮Ӷ
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out, int indent = 0, size_t depth = 0)
+        : out_(out), indent_(indent), first_(depth + 1, 1) {}
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    // ļֵ
+    void key(std::string_view k) {
+        item();
+        appendJsonString(out_, k);
+        out_ += indent_ == 0 ? ":" : ": ";
+        afterKey_ = true;
+    }
+
+    void string(std::string_view s) {
+        item();
+        appendJsonString(out_, s);
+    }
+
+    void number(long long n) {
+        item();
+        char buf[24];
+        snprintf(buf, sizeof(buf), "%lld", n);
+        out_ += buf;
+    }
+
+    void boolean(bool b) {
+        item();
+        out_ += b ? "true" : "false";
+    }
+
+    void null() {
+        item();
+        out_ += "null";
+    }
+
+private:
+    // ֵ֮ǰĶźͻУڼֵ
+    void item() {
+        if (afterKey_) {
+            afterKey_ = false;
+            return;
+        }
+        if (!first_.back()) out_ += ',';
+        first_.back() = 0;
+        if (first_.size() > 1) newline(first_.size() - 1);
+    }
+
+    void open(char c) {
+        item();
+        out_ += c;
+        first_.push_back(1);
+    }
+
+    void close(char c) {
+        bool empty = first_.back();
+        first_.pop_back();
+        if (!empty) newline(first_.size() - 1);
+        out_ += c;
+    }
+
+    void newline(size_t level) {
+        if (indent_ == 0) return;
+        out_ += '\n';
+        out_.append(static_cast<size_t>(indent_) * level, ' ');
+    }
+
+    std::string& out_;
+    int indent_;
+    std::vector<char> first_;  // ÿǷûдֵfirst_[0] Ӧֵ
+    bool afterKey_ = false;
+};
+
+#endif  // JSON_H
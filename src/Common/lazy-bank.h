@@ -0,0 +1,94 @@
+#ifndef LAZY_BANK_H
+#define LAZY_BANK_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bank-store.h"
+#include "mapped-file.h"
+#include "question-bank.h"
+#include "text-encoding.h"
+
+// ⣺ʱֻȡÿļеλãŽ⡣
+// λȴ .qidx ȡģûʱɨһͱǣ
+// ѽд .qidx ´ʹá޸ġɾĿֻͬȡ°汾
+// 򿪺ĿֻÿһλϢʱͳפڴĿݵĶ޹ء
+class LazyBank {
+public:
+    bool open(const std::string& filename) {
+        if (!file_.open(filename)) {
+            std::cerr << "Unable to read file: " << filename << std::endl;
+            return false;
+        }
+        StoreIndexHeader h;
+        std::vector<StoreIndexEntry> entries;
+        bool current = false;
+        if (!readStoreIndex(filename, h, entries, current)) {
+            entries.clear();
+            h = StoreIndexHeader();
+            memcpy(h.magic, kStoreIndexMagic, 4);
+            h.version = kStoreIndexVersion;
+        }
+        if (!current) {
+            std::string_view text = file_.view();
+            h.logBytes += scanStoreLog(text.substr(h.logBytes), h.logBytes, entries, h);
+            if (h.logBytes == text.size()) writeStoreIndex(filename, h, entries);
+        }
+
+        spans_.clear();
+        spans_.reserve(h.liveCount);
+        for (const auto& e : entries) {
+            if (e.live && e.offset + e.length <= file_.size()) spans_.push_back(e);
+        }
+        cache_.clear();
+        cache_.resize(spans_.size());
+        // 밴ļͷжϣ֮ÿʱת
+        utf8_ = detectEncoding(file_.view().substr(0, kEncodingSampleBytes)) == TextEncoding::UTF8;
+        return true;
+    }
+
+    size_t size() const { return spans_.size(); }
+
+    //  i ⣬һηʱöıЧĿʱ nullptr
+    const Question* get(size_t i) {
+        if (i >= spans_.size()) return nullptr;
+        if (!cache_[i]) {
+            auto bank = std::make_unique<QuestionBank>();
+            std::string_view text = file_.view().substr(spans_[i].offset, spans_[i].length);
+            if (utf8_) {
+                utf8ToGbk(text, bank->converted);
+                text = bank->converted;
+            }
+            parseQuestions(text, *bank);
+            cache_[i] = std::move(bank);
+            ++decoded_;
+        }
+        return cache_[i]->questions.empty() ? nullptr : &cache_[i]->questions[0];
+    }
+
+    // ͹ֻÿһеͱǣGBK  UTF-8 ж ASCIIĿ
+    size_t objectiveCount() const {
+        size_t count = 0;
+        for (const auto& span : spans_) {
+            std::string_view text = file_.view().substr(span.offset, span.length);
+            std::string_view line = trimLineEnd(text.substr(0, text.find('\n')));
+            QuestionType type;
+            if (!line.empty() && line[0] == '#' && parseQuestionType(line.substr(1), type) && isObjective(type)) ++count;
+        }
+        return count;
+    }
+
+    // ѽĿ
+    size_t decoded() const { return decoded_; }
+
+private:
+    MappedFile file_;
+    std::vector<StoreIndexEntry> spans_;
+    std::vector<std::unique_ptr<QuestionBank>> cache_;
+    size_t decoded_ = 0;
+    bool utf8_ = false;
+};
+
+#endif  // LAZY_BANK_H
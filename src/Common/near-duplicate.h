@@ -0,0 +1,266 @@
+#ifndef NEAR_DUPLICATE_H
+#define NEAR_DUPLICATE_H
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dedup-index.h"
+#include "mapped-file.h"
+#include "question-bank.h"
+#include "thread-pool.h"
+
+// ࣺĿָֻܷȫͬ⣬дǵͬһҪƶҡ
+// ÿȡɡѡΪο𰸣ƬμϣshingleʣΪӢıʶ򵥸֣
+//  MinHash ǩƬμϵ Jaccard ƶȣ LSH ֶΣǩֳ bands Σÿ rows ֵ
+// һȫͬΪѡֻԺѡƶȣҪȽĿ
+// ƶȲֵĺѡò鼯ϲ飨ƹϵԴݣA~BB~C ʱͬһ飩
+
+// ıÿƬε fn(uint64_t)Ӣıʶ/תСдΪһʣÿΪһʣ
+// һƬΣ㡢հ׺ GBK ֽ 0xA1-0xA9ָֻʣƬΡ
+// ڲصĿ֮Ҳظʲݡprev бɰһı
+template <typename F>
+void forEachShingle(std::string_view text, uint64_t& prev, F&& fn) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    size_t n = text.size(), i = 0;
+    while (i < n) {
+        unsigned char c = p[i];
+        uint64_t word;
+        if (c < 0x80) {
+            bool alnum = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+            if (!alnum) {
+                ++i;
+                continue;
+            }
+            word = kFnvOffset;
+            for (; i < n; ++i) {
+                unsigned char ch = p[i];
+                if (ch >= 'A' && ch <= 'Z') ch = static_cast<unsigned char>(ch - 'A' + 'a');
+                else if (!((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || ch == '_')) break;
+                word = (word ^ ch) * kFnvPrime;
+            }
+        } else if (c >= 0x81 && c <= 0xFE && i + 1 < n && p[i + 1] >= 0x40 && p[i + 1] != 0x7F && p[i + 1] != 0xFF) {
+            word = (uint64_t(1) << 40) | (unsigned(c) << 8) | p[i + 1];
+            i += 2;
+            if (c >= 0xA1 && c <= 0xA9) continue;
+        } else {
+            ++i;
+            continue;
+        }
+        word = mix64(word);
+        if (prev != 0) fn(mix64(prev * 31 + word));
+        prev = word;
+    }
+}
+
+const size_t kMinHashSize = 128;  // ǩȣԼ 1/sqrt(128)
+
+// ǩе i ֵΪ min(h_i(Ƭ))h_i  32 λϵһһӳ䣨˷ӳλ
+//  h_i ϵɹ̶ɣͬһκλϵǩͬڲѭ 128 ֵͬ㣬
+class MinHasher {
+public:
+    MinHasher() {
+        for (size_t i = 0; i < kMinHashSize; ++i) {
+            mul_[i] = static_cast<uint32_t>(mix64(2 * i + 1)) | 1u;
+            add_[i] = static_cast<uint32_t>(mix64(2 * i + 2));
+        }
+    }
+
+    // һǩд out[0..kMinHashSize)ûκƬʱ false
+    bool sign(const Question& q, uint32_t* out) const {
+        uint32_t sig[kMinHashSize];
+        std::fill(sig, sig + kMinHashSize, UINT32_MAX);
+        bool any = false;
+        auto add = [&](uint64_t term) {
+            any = true;
+            uint32_t x = static_cast<uint32_t>(term ^ (term >> 32));
+            for (size_t i = 0; i < kMinHashSize; ++i) {
+                uint32_t v = x * mul_[i] + add_[i];
+                v ^= v >> 15;
+                sig[i] = std::min(sig[i], v);
+            }
+        };
+        // ɡѡο𰸷ֱΪһıƬβԽѡ֮
+        uint64_t prev = 0;
+        for (const auto& line : q.question) forEachShingle(line, prev, add);
+        for (const auto& line : q.options) {
+            prev = 0;
+            forEachShingle(line, prev, add);
+        }
+        prev = 0;
+        for (const auto& line : q.answers) forEachShingle(line, prev, add);
+        std::copy(sig, sig + kMinHashSize, out);
+        return any;
+    }
+
+private:
+    uint32_t mul_[kMinHashSize], add_[kMinHashSize];
+};
+
+// ǩֵͬռƬμ Jaccard ƶȵĹֵ
+inline double signatureSimilarity(const uint32_t* a, const uint32_t* b) {
+    size_t same = 0;
+    for (size_t i = 0; i < kMinHashSize; ++i) same += a[i] == b[i];
+    return static_cast<double>(same) / kMinHashSize;
+}
+
+// ÿεƶǡΪֵ 99% ĸʳΪѡǰȡ
+// Խ󣬵ֵԳΪѡĸԽС
+inline size_t lshRowsFor(double threshold) {
+    size_t best = 1;
+    for (size_t rows = 1; rows <= kMinHashSize; rows *= 2) {
+        double bands = static_cast<double>(kMinHashSize / rows);
+        if (1 - std::pow(1 - std::pow(threshold, static_cast<double>(rows)), bands) >= 0.99) best = rows;
+    }
+    return best;
+}
+
+// Ͱֵʱͬ⣩ÿֻͰǰȽϣƽĺѡ
+const size_t kLshBucketWindow = 32;
+
+// ҳǩƶȲ threshold  (i, j)i < jsignatures Ϊ n ǩ
+// valid[i] Ϊ false ⣨ûƬΣ롣βзͰѡԺϲȥغк˶ƶ
+// candidateCount Ϊʱȥغĺѡ
+inline std::vector<std::pair<uint32_t, uint32_t>> findSimilarPairs(const std::vector<uint32_t>& signatures,
+                                                                   const std::vector<char>& valid, double threshold,
+                                                                   size_t rows, size_t* candidateCount = nullptr) {
+    size_t n = valid.size();
+    size_t bands = kMinHashSize / rows;
+    std::vector<std::vector<uint64_t>> bandCandidates(bands);
+    parallelFor(bands, [&](size_t band) {
+        std::vector<std::pair<uint64_t, uint32_t>> keys;
+        keys.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (!valid[i]) continue;
+            const uint32_t* sig = &signatures[i * kMinHashSize + band * rows];
+            uint64_t h = mix64(band + 1);
+            for (size_t r = 0; r < rows; ++r) h = mix64(h ^ sig[r]);
+            keys.push_back({h, static_cast<uint32_t>(i)});
+        }
+        std::sort(keys.begin(), keys.end());
+        auto& out = bandCandidates[band];
+        for (size_t begin = 0; begin < keys.size();) {
+            size_t end = begin + 1;
+            while (end < keys.size() && keys[end].first == keys[begin].first) ++end;
+            for (size_t a = begin; a < end; ++a) {
+                for (size_t b = a + 1; b < end && b - a <= kLshBucketWindow; ++b) {
+                    out.push_back(uint64_t(keys[a].second) << 32 | keys[b].second);  // keys 
+                }
+            }
+            begin = end;
+        }
+    });
+
+    std::vector<uint64_t> candidates;
+    size_t total = 0;
+    for (const auto& c : bandCandidates) total += c.size();
+    candidates.reserve(total);
+    for (auto& c : bandCandidates) {
+        candidates.insert(candidates.end(), c.begin(), c.end());
+        std::vector<uint64_t>().swap(c);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    if (candidateCount) *candidateCount = candidates.size();
+
+    std::vector<char> similar(candidates.size());
+    parallelFor((candidates.size() + 4095) / 4096, [&](size_t block) {
+        size_t end = std::min(candidates.size(), (block + 1) * 4096);
+        for (size_t k = block * 4096; k < end; ++k) {
+            const uint32_t* a = &signatures[(candidates[k] >> 32) * kMinHashSize];
+            const uint32_t* b = &signatures[(candidates[k] & 0xFFFFFFFF) * kMinHashSize];
+            similar[k] = signatureSimilarity(a, b) >= threshold;
+        }
+    });
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        if (similar[k]) {
+            pairs.push_back({static_cast<uint32_t>(candidates[k] >> 32), static_cast<uint32_t>(candidates[k])});
+        }
+    }
+    return pairs;
+}
+
+// 鼯ϲԣ飨
+inline std::vector<std::vector<uint32_t>> clusterPairs(size_t n,
+                                                      const std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+    std::vector<uint32_t> parent(n);
+    for (size_t i = 0; i < n; ++i) parent[i] = static_cast<uint32_t>(i);
+    auto find = [&](uint32_t x) {
+        while (parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    };
+    for (const auto& [a, b] : pairs) {
+        uint32_t ra = find(a), rb = find(b);
+        if (ra != rb) parent[std::max(ra, rb)] = std::min(ra, rb);  // ʼС
+    }
+    std::vector<uint32_t> slot(n, UINT32_MAX);
+    std::vector<std::vector<uint32_t>> clusters;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t root = find(static_cast<uint32_t>(i));
+        if (root == i) continue;
+        if (slot[root] == UINT32_MAX) {
+            slot[root] = static_cast<uint32_t>(clusters.size());
+            clusters.push_back({root});
+        }
+        clusters[slot[root]].push_back(static_cast<uint32_t>(i));
+    }
+    return clusters;
+}
+
+// ļһ "#CLUSTERS threshold=<ֵ> clusters=<>"֮ÿһУΪڸָƣ16 λʮƣոָ
+// ָƼ¼ɾĿ˳ȻЧ
+inline bool writeClusters(const std::string& path, const std::vector<std::vector<uint64_t>>& clusters,
+                          double threshold) {
+    std::string text;
+    char buf[64];
+    snprintf(buf, sizeof(buf), "#CLUSTERS threshold=%.2f clusters=%zu\n", threshold, clusters.size());
+    text += buf;
+    for (const auto& cluster : clusters) {
+        for (size_t i = 0; i < cluster.size(); ++i) {
+            snprintf(buf, sizeof(buf), i ? " %016llx" : "%016llx", static_cast<unsigned long long>(cluster[i]));
+            text += buf;
+        }
+        text += '\n';
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(text.data(), text.size());
+    out.close();
+    return static_cast<bool>(out);
+}
+
+inline bool loadClusters(const std::string& path, std::vector<std::vector<uint64_t>>& clusters) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    clusters.clear();
+    std::string_view text = file.view();
+    while (!text.empty()) {
+        size_t nl = text.find('\n');
+        std::string_view line = text.substr(0, nl);
+        text = (nl == std::string_view::npos) ? std::string_view() : text.substr(nl + 1);
+        if (line.empty() || line[0] == '#') continue;
+        std::vector<uint64_t> cluster;
+        const char* p = line.data();
+        const char* end = line.data() + line.size();
+        while (p < end) {
+            uint64_t fp = 0;
+            auto res = std::from_chars(p, end, fp, 16);
+            if (res.ec != std::errc()) {
+                ++p;  // ո\r
+                continue;
+            }
+            cluster.push_back(fp);
+            p = res.ptr;
+        }
+        if (cluster.size() > 1) clusters.push_back(std::move(cluster));
+    }
+    return true;
+}
+
+#endif  // NEAR_DUPLICATE_H
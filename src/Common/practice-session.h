@@ -0,0 +1,190 @@
+#ifndef PRACTICE_SESSION_H
+#define PRACTICE_SESSION_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "answer-mask.h"
+#include "bank-snapshot.h"
+#include "question-sampler.h"
+
+// ûϰлỰһֻգÿỰֻ˳ÿѡ˳
+// ÷ֺʹбÿԼ 12 ֽڣټ 8 ֽڣ Question
+// Ự̣߳⹤̶߳ԴỰͬһỰɻỰԼл
+
+// ѡ˳ѹ uint64_tÿѡ 4 λֻǰ 16 ѡౣԭ˳
+const size_t kPackedOptions = 16;
+
+inline uint64_t packOptionOrder(const std::vector<int>& order) {
+    uint64_t packed = 0;
+    for (size_t i = 0; i < order.size() && i < kPackedOptions; ++i) {
+        packed |= static_cast<uint64_t>(order[i]) << (4 * i);
+    }
+    return packed;
+}
+
+inline void unpackOptionOrder(uint64_t packed, size_t count, std::vector<int>& order) {
+    order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = i < kPackedOptions ? static_cast<int>((packed >> (4 * i)) & 0xF) : static_cast<int>(i);
+    }
+}
+
+class PracticeSession {
+public:
+    struct WrongAnswer {
+        uint32_t question;  // еĿ±
+        uint32_t answer;    // ûλͼ
+    };
+
+    // order ΪеĿ±ꣻѡ/ѡѡ˳ seed ң obj-quiz һ
+    PracticeSession(std::shared_ptr<const BankSnapshot> bank, std::vector<uint32_t> order, uint64_t seed)
+        : bank_(std::move(bank)), order_(std::move(order)), options_(order_.size()) {
+        QuizRandom rng(seed);
+        std::vector<int> shuffled;
+        for (size_t i = 0; i < order_.size(); ++i) {
+            const Question& q = bank_->questions[order_[i]];
+            shuffled.resize(std::min(q.options.size(), kPackedOptions));
+            for (size_t j = 0; j < shuffled.size(); ++j) shuffled[j] = static_cast<int>(j);
+            if (questionTypeInfo(q.type).shuffleOptions) shuffleInPlace(shuffled, rng);
+            options_[i] = packOptionOrder(shuffled);
+        }
+        touch();
+    }
+
+    const BankSnapshot& bank() const { return *bank_; }
+    size_t total() const { return order_.size(); }
+    size_t answered() const { return position_; }
+    size_t correct() const { return correct_; }
+    const std::vector<WrongAnswer>& wrong() const { return wrong_; }
+
+    // ǰҪش⣬ȫʱ nullptr
+    const Question* current() const {
+        return position_ < order_.size() ? &bank_->questions[order_[position_]] : nullptr;
+    }
+
+    // ǰѡʾ˳򣺵 i ʾѡԭĵ order[i] 
+    void currentOptionOrder(std::vector<int>& order) const {
+        const Question* q = current();
+        unpackOptionOrder(q ? options_[position_] : 0, q ? q->options.size() : 0, order);
+    }
+
+    // شǰⲢǰһ⣻userMask ذԭѡŵĴλͼ
+    bool answer(std::string_view input, uint32_t& userMask) {
+        const Question* q = current();
+        if (!q) return false;
+        std::vector<int> order;
+        currentOptionOrder(order);
+        userMask = parseUserAnswer(input, order, q->type);
+        bool isCorrect = userMask == q->correctAnswers;
+        if (isCorrect) {
+            ++correct_;
+        } else {
+            wrong_.push_back({order_[position_], userMask});
+        }
+        ++position_;
+        return isCorrect;
+    }
+
+    // Ựռõڴ棨գ
+    size_t memoryBytes() const {
+        return sizeof(*this) + order_.capacity() * sizeof(uint32_t) + options_.capacity() * sizeof(uint64_t) +
+               wrong_.capacity() * sizeof(WrongAnswer);
+    }
+
+    void touch() { lastUsed_ = std::chrono::steady_clock::now(); }
+    std::chrono::steady_clock::time_point lastUsed() const { return lastUsed_; }
+
+    std::mutex mutex;
+
+private:
+    std::shared_ptr<const BankSnapshot> bank_;
+    std::vector<uint32_t> order_;
+    std::vector<uint64_t> options_;
+    std::vector<WrongAnswer> wrong_;
+    uint32_t position_ = 0;
+    uint32_t correct_ = 0;
+    std::chrono::steady_clock::time_point lastUsed_;
+};
+
+// ỰֻжỰʱֻûỰͬỰڲͬ߳ͬʱ
+class SessionManager {
+public:
+    explicit SessionManager(std::chrono::seconds idleTimeout = std::chrono::hours(2))
+        : idleTimeout_(idleTimeout), ids_(randomSeed()) {}
+
+    uint64_t create(std::shared_ptr<const BankSnapshot> bank, std::vector<uint32_t> order, uint64_t seed) {
+        auto session = std::make_shared<PracticeSession>(std::move(bank), std::move(order), seed);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        expireIdleLocked();
+        uint64_t id;
+        do {
+            id = ids_();
+        } while (id == 0 || sessions_.count(id));
+        sessions_.emplace(id, std::move(session));
+        return id;
+    }
+
+    // лỰ fn(PracticeSession&)Ựʱ false
+    template <typename F>
+    bool with(uint64_t id, F&& fn) {
+        std::shared_ptr<PracticeSession> session;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = sessions_.find(id);
+            if (it == sessions_.end()) return false;
+            session = it->second;
+        }
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->touch();
+        fn(*session);
+        return true;
+    }
+
+    bool remove(uint64_t id) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        return sessions_.erase(id) > 0;
+    }
+
+    // ỰȫỰռõڴ
+    void stats(size_t& count, size_t& bytes) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        count = sessions_.size();
+        bytes = 0;
+        for (const auto& s : sessions_) {
+            std::lock_guard<std::mutex> sessionLock(s.second->mutex);
+            bytes += s.second->memoryBytes();
+        }
+    }
+
+private:
+    // ½Ựʱ˳ʱûзʵĻỰ
+    void expireIdleLocked() {
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep_ < std::chrono::minutes(1)) return;
+        lastSweep_ = now;
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            std::unique_lock<std::mutex> sessionLock(it->second->mutex, std::try_to_lock);
+            bool idle = sessionLock.owns_lock() && now - it->second->lastUsed() > idleTimeout_;
+            if (sessionLock.owns_lock()) sessionLock.unlock();
+            it = idle ? sessions_.erase(it) : std::next(it);
+        }
+    }
+
+    std::chrono::seconds idleTimeout_;
+    std::shared_mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<PracticeSession>> sessions_;
+    QuizRandom ids_;
+    std::chrono::steady_clock::time_point lastSweep_ = std::chrono::steady_clock::now();
+};
+
+#endif  // PRACTICE_SESSION_H
@@ -0,0 +1,215 @@
+#ifndef QUESTION_BANK_H
+#define QUESTION_BANK_H
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped-file.h"
+#include "question-type.h"
+#include "text-encoding.h"
+
+// ֻͼָڲ洢һԪ
+template <typename T>
+struct Span {
+    const T* ptr = nullptr;
+    size_t count = 0;
+
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+};
+
+struct Question {
+    QuestionType type = QuestionType::JUDGE;  // ͣ question-type.h
+    Span<std::string_view> question;  // ⣨ı
+    Span<std::string_view> options;   // ѡ
+    Span<std::string_view> answers;   // οҪ
+    uint32_t correctAnswers = 0;      // ȷλͼ i λʾ i ѡ0ʼ
+    uint32_t source = 0;              // Դţϲʱʹ
+};
+
+// ⣺ӳļͼQuestion еͼָ
+struct QuestionBank {
+    MappedFile file;
+    std::string converted;                //  GBK תıǿʱĿͼָ
+    std::vector<std::string_view> lines;  // Ŀõг
+    std::vector<Question> questions;
+};
+
+// λͼλĸ
+inline int bitCount(uint32_t mask) {
+    int n = 0;
+    for (; mask; mask &= mask - 1) ++n;
+    return n;
+}
+
+// λͼ͵λţmask Ϊ 0
+inline int lowestBit(uint32_t mask) {
+    int idx = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        ++idx;
+    }
+    return idx;
+}
+
+// ȥβĿհףкĿոӰʶ
+inline std::string_view trimLineEnd(std::string_view line) {
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+//  "2"  "1,3" ʽĴ𰸱ţ1ʼλͼ 1-32 ıű
+inline uint32_t parseAnswerMask(std::string_view line) {
+    uint32_t mask = 0;
+    const char* p = line.data();
+    const char* end = p + line.size();
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == ',' || *p == '\t')) ++p;
+        int value = 0;
+        auto res = std::from_chars(p, end, value);
+        if (res.ec == std::errc()) {
+            if (value >= 1 && value <= 32) mask |= 1u << (value - 1);
+            p = res.ptr;
+        } else {
+            ++p;  // ޷ʶַ
+        }
+    }
+    return mask;
+}
+
+// ıtext  bank ڱЧ
+inline void parseQuestions(std::string_view text, QuestionBank& bank) {
+    enum State { NONE, IN_QUESTION, IN_OPTIONS, IN_CORRECT, IN_ANSWER } state = NONE;
+
+    // гػݣȼ¼±꣬ٻָ루Ŀͬ
+    enum { Q_LINES, Q_OPTIONS, Q_ANSWERS };
+    std::vector<std::array<size_t, 3>> firsts;
+    firsts.reserve(bank.questions.size());
+    for (const Question& old : bank.questions) {
+        firsts.push_back({size_t(old.question.ptr - bank.lines.data()), size_t(old.options.ptr - bank.lines.data()),
+                          size_t(old.answers.ptr - bank.lines.data())});
+    }
+
+    Question q;
+    std::array<size_t, 3> first{};
+    bool open = false;
+
+    auto beginQuestion = [&](QuestionType type) {
+        q = Question();
+        q.type = type;
+        first = {bank.lines.size(), bank.lines.size(), bank.lines.size()};
+        open = true;
+    };
+    auto finishQuestion = [&]() {
+        if (open) {
+            bank.questions.push_back(q);
+            firsts.push_back(first);
+        }
+        open = false;
+    };
+    // ͬһʱֻһ׷Улʱ¼¼
+    auto startSection = [&](int section) {
+        first[section] = bank.lines.size();
+        (section == Q_OPTIONS ? q.options : q.answers).count = 0;
+    };
+
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* lineEnd = nl ? nl : end;
+        if (lineEnd > p && lineEnd[-1] == '\r') --lineEnd;  //  Windows 
+        std::string_view line(p, lineEnd - p);
+        p = nl ? nl + 1 : end;
+
+        if (!line.empty() && line[0] == '#') {
+            std::string_view marker = trimLineEnd(line);
+            QuestionType type;
+            if (parseQuestionType(marker.substr(1), type)) {  // ȥ#
+                if (open && q.question.count > 0) finishQuestion();
+                beginQuestion(type);
+                state = IN_QUESTION;
+                continue;
+            } else if (marker == "#OPTIONS") {
+                startSection(Q_OPTIONS);
+                state = IN_OPTIONS;
+                continue;
+            } else if (marker == "#CORRECT") {
+                q.correctAnswers = 0;
+                state = IN_CORRECT;
+                continue;
+            } else if (marker == "#ANSWER") {
+                startSection(Q_ANSWERS);
+                state = IN_ANSWER;
+                continue;
+            } else if (marker == "#END" || marker.substr(0, 8) == "#RECORD ") {
+                finishQuestion();  // ¼ͷ bank-store.hͬһ
+                state = NONE;
+                continue;
+            }
+        }
+        if (line.empty() || !open) continue;
+
+        switch (state) {
+            case IN_QUESTION:
+                bank.lines.push_back(line);
+                ++q.question.count;
+                break;
+            case IN_OPTIONS:
+                bank.lines.push_back(line);
+                ++q.options.count;
+                break;
+            case IN_ANSWER:
+                bank.lines.push_back(line);
+                ++q.answers.count;
+                break;
+            case IN_CORRECT:
+                q.correctAnswers |= parseAnswerMask(line);
+                break;
+            default:
+                break;
+        }
+    }
+    if (open && q.question.count > 0) finishQuestion();
+
+    // гѾٱ仯±껻ָ
+    const std::string_view* lines = bank.lines.data();
+    for (size_t i = 0; i < firsts.size(); ++i) {
+        Question& dst = bank.questions[i];
+        dst.question.ptr = lines + firsts[i][Q_LINES];
+        dst.options.ptr = lines + firsts[i][Q_OPTIONS];
+        dst.answers.ptr = lines + firsts[i][Q_ANSWERS];
+    }
+}
+
+// ȡ⣺ӳļʧʱ false
+inline bool loadQuestions(const std::string& filename, QuestionBank& bank) {
+    if (!bank.file.open(filename)) {
+        std::cerr << "Unable to read file: " << filename << std::endl;
+        return false;
+    }
+    bank.lines.clear();
+    bank.questions.clear();
+    bank.converted.clear();
+    // ͳһ GBK ͷʶ UTF-8 ʱȷֿת GBK
+    std::string_view text = bank.file.view();
+    if (detectEncoding(text.substr(0, kEncodingSampleBytes)) == TextEncoding::UTF8) {
+        utf8ToGbk(text, bank.converted);
+        text = bank.converted;
+    }
+    parseQuestions(text, bank);
+    return true;
+}
+
+#endif  // QUESTION_BANK_H
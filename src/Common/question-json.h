@@ -0,0 +1,86 @@
+#ifndef QUESTION_JSON_H
+#define QUESTION_JSON_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "json.h"
+#include "question-bank.h"
+#include "question-sampler.h"
+#include "text-encoding.h"
+
+// Ŀת data/*.json ļ¼Web ʹõĸʽ
+//   ͹ {id, qtype, question, options, answer_index, source}qtype Ϊ judge / single / multiple
+//   ѡ answer_indices гȫȷѡanswer_index еһֻ answer_index ľɴܶȡ
+//    {id, question, answer, source}
+// Ŀı GBKloadQuestions  UTF-8 ת GBKдʱת UTF-8
+
+//  UUID 4 棩 Node  randomUUID ʽͬ
+inline std::string randomUuid() {
+    thread_local QuizRandom rng(randomSeed());
+    uint64_t hi = rng(), lo = rng();
+    hi = (hi & 0xFFFFFFFFFFFF0FFFull) | 0x0000000000004000ull;
+    lo = (lo & 0x3FFFFFFFFFFFFFFFull) | 0x8000000000000000ull;
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%08x-%04x-%04x-%04x-%012llx", unsigned(hi >> 32), unsigned((hi >> 16) & 0xFFFF),
+             unsigned(hi & 0xFFFF), unsigned(lo >> 48), (unsigned long long)(lo & 0xFFFFFFFFFFFFull));
+    return buf;
+}
+
+// дõĻÿ߳һݷʹãдһⲻҪٷڴ
+struct QuestionJsonScratch {
+    std::string gbk, utf8;
+};
+
+//  GBK ıԻӺת UTF-8 д
+template <typename Lines>
+void writeGbkLines(JsonWriter& w, const Lines& lines, QuestionJsonScratch& scratch) {
+    scratch.gbk.clear();
+    for (const auto& line : lines) {
+        if (!scratch.gbk.empty()) scratch.gbk += '\n';
+        scratch.gbk += line;
+    }
+    gbkToUtf8(scratch.gbk, scratch.utf8);
+    w.string(scratch.utf8);
+}
+
+// дһ⣻source  UTF-8 ļ
+inline void writeQuestionJson(JsonWriter& w, const Question& q, std::string_view source, QuestionJsonScratch& scratch) {
+    const char* qtype = questionTypeInfo(q.type).jsonName;
+    w.beginObject();
+    w.key("id");
+    w.string(randomUuid());
+    if (qtype) {
+        w.key("qtype");
+        w.string(qtype);
+    }
+    w.key("question");
+    writeGbkLines(w, q.question, scratch);
+    if (qtype) {
+        w.key("options");
+        w.beginArray();
+        for (std::string_view o : q.options) {
+            gbkToUtf8(o, scratch.utf8);
+            w.string(scratch.utf8);
+        }
+        w.endArray();
+        w.key("answer_index");
+        w.number(q.correctAnswers ? lowestBit(q.correctAnswers) : 0);
+        if (questionTypeInfo(q.type).multipleAnswers) {
+            w.key("answer_indices");
+            w.beginArray();
+            for (uint32_t m = q.correctAnswers; m; m &= m - 1) w.number(lowestBit(m));
+            w.endArray();
+        }
+    } else {
+        w.key("answer");
+        writeGbkLines(w, q.answers, scratch);
+    }
+    w.key("source");
+    w.string(source);
+    w.endObject();
+}
+
+#endif  // QUESTION_JSON_H
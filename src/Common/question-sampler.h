@@ -0,0 +1,158 @@
+#ifndef QUESTION_SAMPLER_H
+#define QUESTION_SAMPLER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// ⣺һ xoshiro256** ʱѡ˳򶼿֡
+// ֻϽУƶ Question 󣻴 n г k Ŀ O(k) n ޹ء
+
+class QuizRandom {
+public:
+    using result_type = uint64_t;
+
+    explicit QuizRandom(uint64_t seed = 0) { reseed(seed); }
+
+    //  splitmix64 չ 256 λ״̬
+    void reseed(uint64_t seed) {
+        for (auto& s : state_) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+
+    uint64_t operator()() {
+        uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // [0, n) оȷֲܾƫn Ϊ 0
+    uint64_t below(uint64_t n) {
+        uint64_t threshold = (0 - n) % n;
+        for (;;) {
+            uint64_t r = (*this)();
+            if (r >= threshold) return r % n;
+        }
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t state_[4];
+};
+
+// δָ --seed ʱʹõ
+inline uint64_t randomSeed() {
+    uint64_t seed = (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}();
+    return seed ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+// Fisher-Yates ϴƣ std::shuffle֤ͬһڲͬ׼Ͻͬ
+template <typename T>
+void shuffleInPlace(std::vector<T>& items, QuizRandom& rng) {
+    for (size_t i = items.size(); i > 1; --i) {
+        size_t j = static_cast<size_t>(rng.below(i));
+        std::swap(items[i - 1], items[j]);
+    }
+}
+
+// Floyd 㷨 [0, n) гȡ min(k, n) ͬ˳ʱڴ涼 O(k)
+inline std::vector<uint32_t> sampleIndices(size_t n, size_t k, QuizRandom& rng) {
+    if (k > n) k = n;
+    std::vector<uint32_t> picks;
+    picks.reserve(k);
+    std::unordered_set<uint32_t> chosen;
+    chosen.reserve(k);
+    for (size_t j = n - k; j < n; ++j) {
+        uint32_t t = static_cast<uint32_t>(rng.below(j + 1));
+        uint32_t pick = chosen.insert(t).second ? t : static_cast<uint32_t>(j);
+        if (pick != t) chosen.insert(pick);
+        picks.push_back(pick);
+    }
+    // Floyd ֻ֤еļϾȣ˳ϴһ
+    shuffleInPlace(picks, rng);
+    return picks;
+}
+
+// ֲstrata Ǹţı k 
+// ÿ Floyd ϲ˳
+inline std::vector<uint32_t> sampleStratified(const std::vector<std::vector<uint32_t>>& strata, size_t k,
+                                              QuizRandom& rng) {
+    size_t total = 0;
+    for (const auto& s : strata) total += s.size();
+    if (k > total) k = total;
+    std::vector<size_t> quota(strata.size());
+    std::vector<std::pair<size_t, size_t>> remainders;  // (, )
+    size_t assigned = 0;
+    for (size_t i = 0; i < strata.size(); ++i) {
+        size_t scaled = k * strata[i].size();
+        quota[i] = total ? scaled / total : 0;
+        assigned += quota[i];
+        if (total) remainders.push_back({scaled % total, i});
+    }
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t r = 0; assigned < k && r < remainders.size(); ++r) {
+        size_t i = remainders[r].second;
+        if (quota[i] < strata[i].size()) {
+            ++quota[i];
+            ++assigned;
+        }
+    }
+
+    std::vector<uint32_t> picks;
+    picks.reserve(k);
+    for (size_t i = 0; i < strata.size(); ++i) {
+        for (uint32_t pos : sampleIndices(strata[i].size(), quota[i], rng)) picks.push_back(strata[i][pos]);
+    }
+    shuffleInPlace(picks, rng);
+    return picks;
+}
+
+//  [0, n) Уе Fisher-Yatesֻ¼λã
+// ȡ m Ŀ O(m)ʺϲ֪ҪٵĿᱻĳ
+class IndexPermutation {
+public:
+    IndexPermutation(size_t n, QuizRandom& rng) : n_(n), rng_(rng) {}
+
+    bool done() const { return next_ >= n_; }
+
+    uint32_t next() {
+        size_t j = next_ + static_cast<size_t>(rng_.below(n_ - next_));
+        uint32_t picked = at(j);
+        swapped_[static_cast<uint32_t>(j)] = at(next_);
+        ++next_;
+        return picked;
+    }
+
+private:
+    uint32_t at(size_t i) const {
+        auto it = swapped_.find(static_cast<uint32_t>(i));
+        return it == swapped_.end() ? static_cast<uint32_t>(i) : it->second;
+    }
+
+    size_t n_;
+    size_t next_ = 0;
+    QuizRandom& rng_;
+    std::unordered_map<uint32_t, uint32_t> swapped_;
+};
+
+#endif  // QUESTION_SAMPLER_H
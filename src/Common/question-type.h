@@ -0,0 +1,109 @@
+#ifndef QUESTION_TYPE_H
+#define QUESTION_TYPE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// ͣʱ #JUDGE ȱȷһΣֻ֮ȽöֵٱȽַ
+// ʾзֺ͵ʱĲ kQuestionTypeInfo Уʱ±
+// ͨ QuestionTypeTraits<T> / visitQuestionType õif constexpr ֱȥҪķ֧
+// ͣöٺͱиһöֵʹ¼еͱţֻ׷ӣ
+// зַʽͲͬʱ parseUserAnswerAsanswer-mask.hмһ if constexpr ֧
+
+enum class QuestionType : uint8_t {
+    JUDGE,
+    CHOICE,
+    MULTICHOICE,
+    SUBJECTIVE,
+};
+
+const size_t kQuestionTypeCount = 4;
+
+struct QuestionTypeInfo {
+    std::string_view name;   // еıǣ #
+    const char* jsonName;    // data/*.json е qtypeΪ nullptr
+    const char* label;       // ʱʾ
+    bool objective;          // ѡλͼз
+    bool shuffleOptions;     // ʱѡ˳
+    bool numberedOptions;    // ѡΪ 1/2Ϊ A/B/C...
+    bool multipleAnswers;    // ѡѡ
+};
+
+constexpr std::array<QuestionTypeInfo, kQuestionTypeCount> kQuestionTypeInfo = {{
+    {"JUDGE", "judge", "[Judge/ж]", true, false, true, false},
+    {"CHOICE", "single", "[Choice/ѡ]", true, true, false, false},
+    {"MULTICHOICE", "multiple", "[Multi-choice/ѡ]", true, true, false, true},
+    {"SUBJECTIVE", nullptr, "[Subjective/]", false, false, false, false},
+}};
+
+constexpr const QuestionTypeInfo& questionTypeInfo(QuestionType type) {
+    return kQuestionTypeInfo[static_cast<size_t>(type)];
+}
+
+constexpr std::string_view questionTypeName(QuestionType type) { return questionTypeInfo(type).name; }
+
+constexpr bool isObjective(QuestionType type) { return questionTypeInfo(type).objective; }
+
+// ǣ #תͣͱʱ false
+inline bool parseQuestionType(std::string_view name, QuestionType& type) {
+    for (size_t i = 0; i < kQuestionTypeCount; ++i) {
+        if (name == kQuestionTypeInfo[i].name) {
+            type = static_cast<QuestionType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ǷΪĿʼıУ#JUDGE ȣ
+inline bool isQuestionMarker(std::string_view line) {
+    QuestionType type;
+    return !line.empty() && line[0] == '#' && parseQuestionType(line.substr(1), type);
+}
+
+template <QuestionType T>
+struct QuestionTypeTraits {
+    static constexpr QuestionType type = T;
+    static constexpr const QuestionTypeInfo& info = kQuestionTypeInfo[static_cast<size_t>(T)];
+};
+
+template <QuestionType T>
+using QuestionTypeTag = std::integral_constant<QuestionType, T>;
+
+// ʱ͵ fn(QuestionTypeTag<T>)fn ڲ԰ decltype(tag)::value ڳ
+template <typename F>
+decltype(auto) visitQuestionType(QuestionType type, F&& fn) {
+    switch (type) {
+        case QuestionType::JUDGE: return fn(QuestionTypeTag<QuestionType::JUDGE>());
+        case QuestionType::CHOICE: return fn(QuestionTypeTag<QuestionType::CHOICE>());
+        case QuestionType::MULTICHOICE: return fn(QuestionTypeTag<QuestionType::MULTICHOICE>());
+        default: return fn(QuestionTypeTag<QuestionType::SUBJECTIVE>());
+    }
+}
+
+// ͷţÿڵĿͬһʱǱڳѭûͷ֧
+using TypePartitions = std::array<std::vector<uint32_t>, kQuestionTypeCount>;
+
+template <typename Questions>
+TypePartitions partitionByType(const Questions& questions) {
+    TypePartitions parts;
+    for (size_t i = 0; i < questions.size(); ++i) {
+        parts[static_cast<size_t>(questions[i].type)].push_back(static_cast<uint32_t>(i));
+    }
+    return parts;
+}
+
+// ζÿǿշ fn(QuestionTypeTag<T>, const vector<uint32_t>& )
+template <typename F>
+void forEachPartition(const TypePartitions& parts, F&& fn) {
+    for (size_t t = 0; t < kQuestionTypeCount; ++t) {
+        if (parts[t].empty()) continue;
+        visitQuestionType(static_cast<QuestionType>(t), [&](auto tag) { fn(tag, parts[t]); });
+    }
+}
+
+#endif  // QUESTION_TYPE_H
@@ -0,0 +1,283 @@
+#ifndef REVIEW_SCHEDULER_H
+#define REVIEW_SCHEDULER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "answer-journal.h"
+#include "dedup-index.h"
+#include "question-bank.h"
+
+// ظSM-2ϰȣÿⰴָƱѶϵ´θϰʱ䣬
+// ԺѶϵ㲢ڼӺ³֡
+
+const int64_t kDaySeconds = 24 * 60 * 60;
+const int64_t kRelearnSeconds = 10 * 60;  // ٴγ
+const uint16_t kInitialEase = 2500;       // Ѷϵ 1000
+const uint16_t kMinEase = 1300;
+const size_t kNewPerSession = 20;         // һθϰ⣨ûиϰ¼⣩
+
+struct ReviewState {
+    uint64_t fingerprint;
+    int64_t due;        // ´θϰʱ䣨Unix 룩
+    uint32_t interval;  // ǰ죩
+    uint16_t ease;      // Ѷϵ 1000
+    uint16_t reps;      // Դ
+    uint16_t lapses;    // ۼƴ
+    uint16_t reserved;
+    uint32_t attempts;  // ۼ
+};
+
+//  SM-2 ״̬quality Ϊ 0-5С 3 Ϊû
+inline void applyReview(ReviewState& s, int quality, int64_t now) {
+    quality = std::max(0, std::min(5, quality));
+    ++s.attempts;
+    if (quality < 3) {
+        s.reps = 0;
+        ++s.lapses;
+        s.interval = 0;
+        s.due = now + kRelearnSeconds;
+    } else {
+        ++s.reps;
+        if (s.reps == 1) {
+            s.interval = 1;
+        } else if (s.reps == 2) {
+            s.interval = 6;
+        } else {
+            s.interval = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(s.interval * (s.ease / 1000.0))));
+        }
+        s.due = now + int64_t(s.interval) * kDaySeconds;
+    }
+    int d = 5 - quality;
+    int ease = s.ease + 100 - d * (80 + d * 20);
+    s.ease = static_cast<uint16_t>(std::max<int>(kMinEase, std::min(ease, 5000)));
+}
+
+// ϰ¼ļ.qrsReviewStoreHeader + ReviewState[count]дʱļ滻
+const char kReviewMagic[4] = {'Q', 'R', 'V', 'S'};
+const uint32_t kReviewVersion = 1;
+
+struct ReviewStoreHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+};
+
+class ReviewStore {
+public:
+    bool load(const std::string& path) {
+        states_.clear();
+        index_ = FingerprintIndex();
+        MappedFile file;
+        if (!file.open(path) || file.size() < sizeof(ReviewStoreHeader)) return false;
+        ReviewStoreHeader h;
+        memcpy(&h, file.data(), sizeof(h));
+        if (memcmp(h.magic, kReviewMagic, 4) != 0 || h.version != kReviewVersion ||
+            h.count > (file.size() - sizeof(h)) / sizeof(ReviewState)) {
+            return false;
+        }
+        states_.resize(h.count);
+        if (h.count > 0) memcpy(states_.data(), file.data() + sizeof(h), h.count * sizeof(ReviewState));
+        index_ = FingerprintIndex(states_.size());
+        for (size_t i = 0; i < states_.size(); ++i) index_.insert(states_[i].fingerprint, static_cast<uint32_t>(i));
+        return true;
+    }
+
+    bool save(const std::string& path) const {
+        ReviewStoreHeader h{};
+        memcpy(h.magic, kReviewMagic, 4);
+        h.version = kReviewVersion;
+        h.count = states_.size();
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+            out.write(reinterpret_cast<const char*>(states_.data()),
+                      static_cast<std::streamsize>(states_.size() * sizeof(ReviewState)));
+            if (!out) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        return !ec;
+    }
+
+    const ReviewState* find(uint64_t fp) const {
+        long long idx = index_.find(fp);
+        return idx < 0 ? nullptr : &states_[idx];
+    }
+
+    // ¼һ𣬷ظº״̬
+    const ReviewState& review(uint64_t fp, int quality, int64_t now) {
+        long long idx = index_.find(fp);
+        if (idx < 0) {
+            idx = static_cast<long long>(states_.size());
+            ReviewState s{};
+            s.fingerprint = fp;
+            s.ease = kInitialEase;
+            states_.push_back(s);
+            index_.insert(fp, static_cast<uint32_t>(idx));
+        }
+        applyReview(states_[idx], quality, now);
+        return states_[idx];
+    }
+
+    size_t size() const { return states_.size(); }
+
+private:
+    std::vector<ReviewState> states_;
+    FingerprintIndex index_;
+};
+
+// ڶУиϰ¼ⰴ´θϰʱųСѣȡһڶ O(log n)
+// ûиϰ¼ⲻ㵽ڣ˳ں棺ѵڵⶼϰųÿ newLimit 
+class DueQueue {
+public:
+    DueQueue(const ReviewStore& store, const std::vector<uint64_t>& fingerprints, size_t newLimit = kNewPerSession) {
+        std::vector<Item> items;
+        items.reserve(fingerprints.size());
+        for (size_t i = 0; i < fingerprints.size(); ++i) {
+            const ReviewState* s = store.find(fingerprints[i]);
+            if (s) {
+                items.push_back({s->due, static_cast<uint32_t>(i)});
+            } else if (fresh_.size() < newLimit) {
+                fresh_.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        heap_ = std::priority_queue<Item, std::vector<Item>, std::greater<Item>>(std::greater<Item>(), std::move(items));
+    }
+
+    // ȡһѵڵĿ±꣬ûʱȡһ⣬ûʱ -1
+    long long popDue(int64_t now) {
+        if (heap_.empty() || heap_.top().first > now) {
+            return nextFresh_ < fresh_.size() ? fresh_[nextFresh_++] : -1;
+        }
+        uint32_t idx = heap_.top().second;
+        heap_.pop();
+        return idx;
+    }
+
+    // λ
+    size_t newCount() const { return fresh_.size() - nextFresh_; }
+
+    void push(size_t index, int64_t due) { heap_.push({due, static_cast<uint32_t>(index)}); }
+
+    size_t dueCount(int64_t now) const {
+        // ʾһݶ
+        auto copy = heap_;
+        size_t n = 0;
+        while (!copy.empty() && copy.top().first <= now) {
+            copy.pop();
+            ++n;
+        }
+        return n;
+    }
+
+private:
+    using Item = std::pair<int64_t, uint32_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap_;
+    std::vector<uint32_t> fresh_;
+    size_t nextFresh_ = 0;
+};
+
+// öƴ¼.qjlطʷ¼ԴʱͶԴ
+inline size_t importJournalHistory(const std::string& path, ReviewStore& store) {
+    return readJournal(path, [&](const JournalEntry& e, std::string_view) {
+        store.review(e.fingerprint, e.correct ? 4 : 1, e.time);
+    });
+}
+
+// ȥⱾѡǰ "A. " / "1. " 
+inline std::string_view stripOptionLabel(std::string_view line) {
+    size_t dot = line.find(". ");
+    if (dot != std::string_view::npos && dot > 0 && dot <= 2) return line.substr(dot + 2);
+    return line;
+}
+
+// ȷѡԶƴӶɣжĳѡǷ
+inline bool answerLineHas(std::string_view line, std::string_view option) {
+    if (option.empty()) return false;
+    for (size_t pos = line.find(option); pos != std::string_view::npos; pos = line.find(option, pos + 1)) {
+        bool left = pos == 0 || line[pos - 1] == ',';
+        bool right = pos + option.size() == line.size() || line[pos + option.size()] == ',';
+        if (left && right) return true;
+    }
+    return false;
+}
+
+// ı¼obj-answers.txt / sub-answer.txtطʷı¼ûʱ䣬
+// ȫ now ֮ǰ kRelearnSeconds ƣ͹Ȿֻ¼⣬ÿΪһδʱѵڣ
+// ¼ûжԴÿΪһǿͨquality 3
+inline size_t importTextHistory(const std::string& path, ReviewStore& store, int64_t now) {
+    MappedFile file;
+    if (!file.open(path)) return 0;
+
+    enum State { NONE, IN_QUESTION, IN_OPTIONS, IN_USER, IN_CORRECT } state = NONE;
+    std::vector<std::string_view> stem, options, correctLines;
+    QuestionType type = QuestionType::JUDGE;
+    bool open = false;
+    size_t count = 0;
+
+    auto finish = [&]() {
+        if (!open || stem.empty()) return;
+        Question q;
+        q.type = type;
+        q.question = {stem.data(), stem.size()};
+        if (!isObjective(type)) {
+            q.answers = {correctLines.data(), correctLines.size()};
+        } else {
+            q.options = {options.data(), options.size()};
+            std::string_view correct = correctLines.empty() ? std::string_view() : correctLines[0];
+            for (size_t i = 0; i < options.size() && i < 32; ++i) {
+                if (answerLineHas(correct, options[i])) q.correctAnswers |= 1u << i;
+            }
+        }
+        store.review(questionFingerprint(q), isObjective(type) ? 1 : 3, now - kRelearnSeconds);
+        ++count;
+    };
+
+    std::string_view text = file.view();
+    while (!text.empty()) {
+        size_t nl = text.find('\n');
+        std::string_view line = text.substr(0, nl);
+        text = (nl == std::string_view::npos) ? std::string_view() : text.substr(nl + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        std::string_view marker = trimLineEnd(line);
+        if (isQuestionMarker(marker)) {
+            parseQuestionType(marker.substr(1), type);
+            open = true;
+            stem.clear();
+            options.clear();
+            correctLines.clear();
+            state = IN_QUESTION;
+        } else if (marker == "#OPTIONS") {
+            state = IN_OPTIONS;
+        } else if (marker == "#USER_ANSWER") {
+            state = IN_USER;
+        } else if (marker == "#CORRECT_ANSWER") {
+            state = IN_CORRECT;
+        } else if (marker == "#END") {
+            finish();
+            open = false;
+            state = NONE;
+        } else if (!line.empty()) {
+            if (state == IN_QUESTION) stem.push_back(line);
+            else if (state == IN_OPTIONS) options.push_back(stripOptionLabel(line));
+            else if (state == IN_CORRECT) correctLines.push_back(line);
+        }
+    }
+    return count;
+}
+
+#endif  // REVIEW_SCHEDULER_H
@@ -0,0 +1,258 @@
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dedup-index.h"
+#include "mapped-file.h"
+#include "question-bank.h"
+#include "thread-pool.h"
+
+// ȫļÿӦĿб򣩡
+// ִ GBK ԭϽУת
+//   Ӣıʶ/֣ [A-Za-z0-9_] ΪһʣͳһתСд
+//   ֣ÿΪһʣͬʱɶԪʣbigram
+//         ѯִʱ൱ҪжԪʶ
+//   GBK ֽ 0xA1-0xA9ȫǱȣ ASCII ַΪָ
+// ֻ 64 λϣִʹ̲ڴ档
+
+// ÿ fn(uint64_t term)
+template <typename F>
+void forEachToken(std::string_view text, F&& fn) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    size_t n = text.size();
+    unsigned prevChar = 0;  // һֽ֣ڣ0 ʾںִ
+    size_t i = 0;
+    while (i < n) {
+        unsigned char c = p[i];
+        if (c < 0x80) {
+            prevChar = 0;
+            bool word = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+            if (!word) {
+                ++i;
+                continue;
+            }
+            uint64_t h = kFnvOffset;
+            for (; i < n; ++i) {
+                unsigned char ch = p[i];
+                if (ch >= 'A' && ch <= 'Z') ch = static_cast<unsigned char>(ch - 'A' + 'a');
+                else if (!((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || ch == '_')) break;
+                h = (h ^ ch) * kFnvPrime;
+            }
+            fn(mix64(h));
+        } else if (c >= 0x81 && c <= 0xFE && i + 1 < n && p[i + 1] >= 0x40 && p[i + 1] != 0x7F && p[i + 1] != 0xFF) {
+            unsigned ch = (unsigned(c) << 8) | p[i + 1];
+            i += 2;
+            if (c >= 0xA1 && c <= 0xA9) {
+                prevChar = 0;
+                continue;
+            }
+            // ֺͶԪʷֱϲͬĸλӢĴʵĹϣֿ
+            fn(mix64((uint64_t(1) << 40) | ch));
+            if (prevChar != 0) fn(mix64((uint64_t(2) << 40) | (uint64_t(prevChar) << 16) | ch));
+            prevChar = ch;
+        } else {
+            prevChar = 0;
+            ++i;
+        }
+    }
+}
+
+// һɡѡͲο𰸷ִ
+template <typename F>
+void forEachQuestionToken(const Question& q, F&& fn) {
+    for (const auto& line : q.question) forEachToken(line, fn);
+    for (const auto& line : q.options) forEachToken(line, fn);
+    for (const auto& line : q.answers) forEachToken(line, fn);
+}
+
+// ļ.qsxSearchIndexHeader + uint64_t [termCount]
+//                  + uint32_t ƫ[termCount + 1] + uint32_t Ŀ[postingCount]
+const char kSearchMagic[4] = {'Q', 'S', 'I', 'X'};
+const uint32_t kSearchVersion = 1;
+
+struct SearchIndexHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t docCount;
+    uint32_t termCount;
+    uint64_t postingCount;
+};
+
+//  xxx.txt  xxx.qsx
+inline std::string searchIndexPath(const std::string& filename) {
+    std::string path = filename;
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".txt") == 0) {
+        path.resize(path.size() - 4);
+    }
+    return path + ".qsx";
+}
+
+class SearchIndex {
+public:
+    SearchIndex() = default;
+    SearchIndex(const SearchIndex&) = delete;
+    SearchIndex& operator=(const SearchIndex&) = delete;
+
+    // ΪеȫĿĿż questions е±
+    void build(const std::vector<Question>& questions) {
+        std::vector<std::pair<uint64_t, uint32_t>> pairs;
+        for (size_t i = 0; i < questions.size(); ++i) {
+            size_t first = pairs.size();
+            forEachQuestionToken(questions[i], [&](uint64_t term) { pairs.emplace_back(term, static_cast<uint32_t>(i)); });
+            // ͬһȥ
+            std::sort(pairs.begin() + first, pairs.end());
+            pairs.erase(std::unique(pairs.begin() + first, pairs.end()), pairs.end());
+        }
+        std::sort(pairs.begin(), pairs.end());
+
+        std::vector<uint64_t> terms;
+        std::vector<uint32_t> offsets;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            if (i == 0 || pairs[i].first != pairs[i - 1].first) {
+                terms.push_back(pairs[i].first);
+                offsets.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        offsets.push_back(static_cast<uint32_t>(pairs.size()));
+
+        SearchIndexHeader h{};
+        memcpy(h.magic, kSearchMagic, 4);
+        h.version = kSearchVersion;
+        h.docCount = static_cast<uint32_t>(questions.size());
+        h.termCount = static_cast<uint32_t>(terms.size());
+        h.postingCount = pairs.size();
+
+        owned_.clear();
+        owned_.reserve(sizeof(h) + terms.size() * 8 + offsets.size() * 4 + pairs.size() * 4);
+        owned_.append(reinterpret_cast<const char*>(&h), sizeof(h));
+        owned_.append(reinterpret_cast<const char*>(terms.data()), terms.size() * sizeof(uint64_t));
+        owned_.append(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+        for (const auto& p : pairs) owned_.append(reinterpret_cast<const char*>(&p.second), sizeof(uint32_t));
+        file_.close();
+        attach(owned_.data(), owned_.size());
+    }
+
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(data_, static_cast<std::streamsize>(size_));
+        return static_cast<bool>(out);
+    }
+
+    // ӳļݣdocCount ʱΪЧ
+    bool load(const std::string& path, size_t docCount) {
+        owned_.clear();
+        if (!file_.open(path)) return false;
+        if (!attach(file_.data(), file_.size()) || docCount_ != docCount) {
+            file_.close();
+            reset();
+            return false;
+        }
+        return true;
+    }
+
+    // ѯذѯȫĿţ
+    std::vector<uint32_t> search(std::string_view query) const {
+        std::vector<std::pair<const uint32_t*, const uint32_t*>> lists;
+        bool missing = false;
+        forEachToken(query, [&](uint64_t term) {
+            const uint64_t* it = std::lower_bound(terms_, terms_ + termCount_, term);
+            if (it == terms_ + termCount_ || *it != term) {
+                missing = true;
+                return;
+            }
+            size_t t = it - terms_;
+            lists.emplace_back(postings_ + offsets_[t], postings_ + offsets_[t + 1]);
+        });
+        std::vector<uint32_t> result;
+        if (missing || lists.empty()) return result;
+
+        // ̵бʼ󽻼
+        std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) {
+            return a.second - a.first < b.second - b.first;
+        });
+        result.assign(lists[0].first, lists[0].second);
+        for (size_t k = 1; k < lists.size() && !result.empty(); ++k) {
+            size_t out = 0;
+            const uint32_t* p = lists[k].first;
+            for (uint32_t doc : result) {
+                p = std::lower_bound(p, lists[k].second, doc);
+                if (p == lists[k].second) break;
+                if (*p == doc) result[out++] = doc;
+            }
+            result.resize(out);
+        }
+        return result;
+    }
+
+    size_t docCount() const { return docCount_; }
+    size_t termCount() const { return termCount_; }
+
+private:
+    bool attach(const char* data, size_t size) {
+        reset();
+        SearchIndexHeader h;
+        if (size < sizeof(h)) return false;
+        memcpy(&h, data, sizeof(h));
+        if (memcmp(h.magic, kSearchMagic, 4) != 0 || h.version != kSearchVersion) return false;
+        size_t need = sizeof(h) + size_t(h.termCount) * 8 + (size_t(h.termCount) + 1) * 4 + h.postingCount * 4;
+        if (need > size) return false;
+        data_ = data;
+        size_ = need;
+        docCount_ = h.docCount;
+        termCount_ = h.termCount;
+        terms_ = reinterpret_cast<const uint64_t*>(data + sizeof(h));
+        offsets_ = reinterpret_cast<const uint32_t*>(terms_ + termCount_);
+        postings_ = offsets_ + termCount_ + 1;
+        return true;
+    }
+
+    void reset() {
+        data_ = nullptr;
+        size_ = docCount_ = termCount_ = 0;
+        terms_ = nullptr;
+        offsets_ = postings_ = nullptr;
+    }
+
+    MappedFile file_;
+    std::string owned_;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t docCount_ = 0;
+    size_t termCount_ = 0;
+    const uint64_t* terms_ = nullptr;
+    const uint32_t* offsets_ = nullptr;
+    const uint32_t* postings_ = nullptr;
+};
+
+// ȡڲ .txt  .qsx ʱֱӳ䣬½д
+inline bool loadSearchIndex(const std::string& filename, const QuestionBank& bank, SearchIndex& index) {
+    namespace fs = std::filesystem;
+    std::string path = searchIndexPath(filename);
+    std::error_code ec;
+    if (fs::exists(path, ec)) {
+        bool stale = fs::exists(filename, ec) &&
+                     fs::last_write_time(filename, ec) > fs::last_write_time(path, ec);
+        if (!stale && index.load(path, bank.questions.size())) return true;
+    }
+    index.build(bank.questions);
+    return index.save(path);
+}
+
+// ΪⲢжȡ/
+inline void loadSearchIndexes(const std::vector<std::string>& files, const std::vector<QuestionBank>& banks,
+                              std::vector<SearchIndex>& indexes) {
+    indexes = std::vector<SearchIndex>(banks.size());
+    parallelFor(banks.size(), [&](size_t i) { loadSearchIndex(files[i], banks[i], indexes[i]); });
+}
+
+#endif  // SEARCH_INDEX_H
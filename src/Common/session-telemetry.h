@@ -0,0 +1,303 @@
+#ifndef SESSION_TELEMETRY_H
+#define SESSION_TELEMETRY_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "answer-journal.h"
+#include "mapped-file.h"
+
+// Ựʱ¼߸׶Σءʾз֡дⱾĺʱѧϰÿʱ䡣
+// ÿ¼дλͬʱۼӵý׶εļֱͼʱͳ˳ʱ
+// ¼ɿ׷ӵỰ־.qtl¼һ¼ֻмԭӲڴ档
+//
+// ־ʽɿ飬ÿ TelemetryChunkHeader + count  TelemetryEventУͣ
+// ͬһỰĿ sessionId ͬ˳ʱĩβĿڶȡʱԡ
+
+enum class TelemetryPhase : uint8_t { LOAD, PARSE, RENDER, ANSWER, GRADE, JOURNAL, COUNT };
+
+const char* const kTelemetryPhaseNames[] = {"load", "parse", "render", "answer", "grade", "journal"};
+const char* const kTelemetryProgramNames[] = {"obj-quiz", "sub-quiz"};
+
+const uint32_t kTelemetryMagic = 0x314C5451;  // "QTL1"
+const uint16_t kTelemetryVersion = 1;
+
+struct TelemetryChunkHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t program;     // kTelemetryProgramNames ±
+    uint8_t reserved;
+    uint64_t sessionId;  // Ựʼʱ䣨Unix ΢룩
+    uint32_t count;      // ¼
+    uint32_t dropped;    // ʱ¼ۼƣ
+    uint32_t checksum;   // Աȫ¼ FNV-1a 32 λУ
+    uint32_t reserved2;
+};
+
+struct TelemetryEvent {
+    uint64_t fingerprint;  // ĿָƣĿ޹ص¼Ϊ 0
+    uint64_t startNs;      // ʼʱ䣬Ựʼ
+    uint64_t durationNs;
+    uint32_t question;     // λỰеţ 1 ʼĿ޹ص¼Ϊ 0
+    uint8_t phase;         // TelemetryPhase
+    uint8_t result;        // ANSWER ¼1  / 0 Ϊ 0
+    uint16_t reserved;
+};
+
+// нУ߶ߣVyukov 㷨ÿλţߺ߸ CAS λ
+template <typename T, size_t Capacity>
+class RingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    RingBuffer() {
+        for (size_t i = 0; i < Capacity; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // ʱ false
+    bool push(const T& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & (Capacity - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // ʱ false
+    bool pop(T& value) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & (Capacity - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(pos + Capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // µԪظʱֻο
+    size_t size() const {
+        return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    Cell cells_[Capacity];
+};
+
+// -ֱͼÿ 2 ٷ 8  12.5%λ
+class LatencyHistogram {
+public:
+    static const int kSubBuckets = 8;
+    static const int kBuckets = 64 * kSubBuckets;
+
+    static int bucketOf(uint64_t v) {
+        if (v < kSubBuckets) return static_cast<int>(v);
+        int msb = 63 - __builtin_clzll(v);
+        return (msb - 2) * kSubBuckets + static_cast<int>((v >> (msb - 3)) & (kSubBuckets - 1));
+    }
+
+    // ͰֵϽ
+    static uint64_t bucketUpper(int b) {
+        if (b < kSubBuckets) return static_cast<uint64_t>(b);
+        int msb = b / kSubBuckets + 2;
+        uint64_t sub = static_cast<uint64_t>(b % kSubBuckets);
+        return ((kSubBuckets + sub + 1) << (msb - 3)) - 1;
+    }
+
+    void add(uint64_t v) {
+        counts_[bucketOf(v)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(v, std::memory_order_relaxed);
+        uint64_t m = max_.load(std::memory_order_relaxed);
+        while (v > m && !max_.compare_exchange_weak(m, v, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    //  p λ0-1ͰϽ磬ֵ
+    uint64_t percentile(double p) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p * (n - 1)) + 1, seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += counts_[b].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(bucketUpper(b), max());
+        }
+        return max();
+    }
+
+private:
+    std::atomic<uint32_t> counts_[kBuckets] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+class SessionTelemetry {
+public:
+    static const size_t kRingCapacity = 4096;
+
+    ~SessionTelemetry() { close(); }
+
+    // ʼ¼Ự¼׷ӵ pathʱм¼ǿղ
+    bool open(const std::string& path, uint8_t program) {
+        close();
+        start_ = std::chrono::steady_clock::now();
+        sessionId_ = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                               std::chrono::system_clock::now().time_since_epoch())
+                                               .count());
+        program_ = program;
+        log_.flushBytes = 0;  // ÿֱд
+        enabled_ = log_.open(path);
+        return enabled_;
+    }
+
+    bool enabled() const { return enabled_; }
+
+    // Ựʼʱӣ
+    uint64_t now() const {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+    void record(TelemetryPhase phase, uint64_t start, uint64_t end, uint32_t question = 0,
+                uint64_t fingerprint = 0, uint8_t result = 0) {
+        if (!enabled_) return;
+        TelemetryEvent e{};
+        e.fingerprint = fingerprint;
+        e.startNs = start;
+        e.durationNs = end > start ? end - start : 0;
+        e.question = question;
+        e.phase = static_cast<uint8_t>(phase);
+        e.result = result;
+        histograms_[e.phase].add(e.durationNs);
+        if (!ring_->push(e)) {
+            flush();
+            if (!ring_->push(e)) dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (ring_->size() >= kRingCapacity / 2) flush();
+    }
+
+    const LatencyHistogram& histogram(TelemetryPhase phase) const {
+        return histograms_[static_cast<size_t>(phase)];
+    }
+
+    // ѻе¼Ϊһд־ͬһʱֻһ߳дֱ߳ӷ
+    void flush() {
+        if (!enabled_ || draining_.test_and_set(std::memory_order_acquire)) return;
+        std::string chunk(sizeof(TelemetryChunkHeader), '\0');
+        TelemetryEvent e;
+        uint32_t count = 0;
+        while (ring_->pop(e)) {
+            chunk.append(reinterpret_cast<const char*>(&e), sizeof(e));
+            ++count;
+        }
+        if (count > 0) {
+            TelemetryChunkHeader h{};
+            h.magic = kTelemetryMagic;
+            h.version = kTelemetryVersion;
+            h.program = program_;
+            h.sessionId = sessionId_;
+            h.count = count;
+            h.dropped = dropped_.load(std::memory_order_relaxed);
+            h.checksum = journalChecksum(chunk.data() + sizeof(h), chunk.size() - sizeof(h));
+            memcpy(&chunk[0], &h, sizeof(h));
+            log_.append(chunk);
+        }
+        draining_.clear(std::memory_order_release);
+    }
+
+    void close() {
+        if (!enabled_) return;
+        flush();
+        log_.close();
+        enabled_ = false;
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+    uint64_t sessionId_ = 0;
+    uint8_t program_ = 0;
+    bool enabled_ = false;
+    AnswerJournal log_;
+    std::unique_ptr<RingBuffer<TelemetryEvent, kRingCapacity>> ring_ =
+        std::make_unique<RingBuffer<TelemetryEvent, kRingCapacity>>();
+    LatencyHistogram histograms_[static_cast<size_t>(TelemetryPhase::COUNT)];
+    std::atomic<uint32_t> dropped_{0};
+    std::atomic_flag draining_ = ATOMIC_FLAG_INIT;
+};
+
+// õĻỰ¼˳ʱԶдʣ¼
+inline SessionTelemetry& telemetry() {
+    static SessionTelemetry instance;
+    return instance;
+}
+
+// ȡỰ־УʧܵĿʱֹͣضȡĿ
+template <typename F>
+size_t readTelemetryLog(const std::string& path, F&& fn) {
+    MappedFile file;
+    if (!file.open(path)) return 0;
+    const char* p = file.data();
+    const char* end = p + file.size();
+    size_t chunks = 0;
+    std::unique_ptr<TelemetryEvent[]> events;
+    size_t capacity = 0;
+    while (static_cast<size_t>(end - p) >= sizeof(TelemetryChunkHeader)) {
+        TelemetryChunkHeader h;
+        memcpy(&h, p, sizeof(h));
+        size_t bytes = static_cast<size_t>(h.count) * sizeof(TelemetryEvent);
+        if (h.magic != kTelemetryMagic || h.version != kTelemetryVersion ||
+            bytes > static_cast<size_t>(end - p) - sizeof(h)) {
+            break;
+        }
+        const char* body = p + sizeof(h);
+        if (journalChecksum(body, bytes) != h.checksum) break;
+        if (h.count > capacity) {
+            capacity = h.count;
+            events = std::make_unique<TelemetryEvent[]>(capacity);
+        }
+        memcpy(events.get(), body, bytes);  // ӳַ֤룬ȸ
+        fn(h, events.get(), static_cast<size_t>(h.count));
+        ++chunks;
+        p = body + bytes;
+    }
+    return chunks;
+}
+
+#endif  // SESSION_TELEMETRY_H
@@ -0,0 +1,278 @@
+#ifndef TEXT_ENCODING_H
+#define TEXT_ENCODING_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "gbk-table.h"
+
+// GBK  UTF-8 ֮ʽת룺ֿ飬İַݴתС
+// ASCII ֱͬתʱҳ ASCII θƣSSE2 ÿμ 16 ֽڣ
+// ÿμ 8 ֽڣֻз ASCII ַŲ
+// ޷תַ UTF-8 ʱ滻Ϊ U+FFFD GBK ʱ滻Ϊ '?'
+
+enum class TextEncoding { ASCII, UTF8, GBK };
+
+inline const char* encodingName(TextEncoding e) {
+    switch (e) {
+        case TextEncoding::ASCII: return "ASCII";
+        case TextEncoding::UTF8: return "UTF-8";
+        default: return "GBK";
+    }
+}
+
+// ش p ʼ ASCII ֽڵĳ
+inline size_t asciiPrefix(const char* p, size_t n) {
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= n; i += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+        if (mask != 0) return i + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, 8);
+        if (word & 0x8080808080808080ull) break;
+    }
+    while (i < n && static_cast<unsigned char>(p[i]) < 0x80) ++i;
+    return i;
+}
+
+// д UTF-8дλ
+inline char* writeUtf8(char* w, uint32_t cp) {
+    if (cp < 0x80) {
+        *w++ = static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        *w++ = static_cast<char>(0xC0 | (cp >> 6));
+        *w++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *w++ = static_cast<char>(0xE0 | (cp >> 12));
+        *w++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *w++ = static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        *w++ = static_cast<char>(0xF0 | (cp >> 18));
+        *w++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        *w++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *w++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return w;
+}
+
+// GBK ˫ַֽת Unicode޴ַʱ 0
+inline uint32_t gbkToUnicode(unsigned char lead, unsigned char trail) {
+    if (lead < 0x81 || lead > 0xFE || trail < 0x40 || trail > 0xFE) return 0;
+    return kGbkToUnicode[(lead - 0x81) * kGbkTrailCount + (trail - 0x40)];
+}
+
+// Unicode ת GBK ˫ֽڱ루ֽΪֽڣ޴ַʱ 0һʹʱ
+inline uint16_t unicodeToGbk(uint32_t cp) {
+    static const std::vector<uint16_t> table = [] {
+        std::vector<uint16_t> t(0x10000, 0);
+        for (unsigned lead = 0; lead < kGbkLeadCount; ++lead) {
+            for (unsigned trail = 0; trail < kGbkTrailCount; ++trail) {
+                uint16_t u = kGbkToUnicode[lead * kGbkTrailCount + trail];
+                if (u != 0 && t[u] == 0) t[u] = static_cast<uint16_t>(((lead + 0x81) << 8) | (trail + 0x40));
+            }
+        }
+        return t;
+    }();
+    return cp < 0x10000 ? table[cp] : 0;
+}
+
+// תȰֱָд룬صಿ
+class GbkToUtf8 {
+public:
+    // תһ룬׷ӵ out
+    void feed(std::string_view in, std::string& out) {
+        const char* p = in.data();
+        size_t n = in.size();
+        size_t start = out.size();
+        out.resize(start + n * 3 + 3);  // ÿֽ 3 ֽ
+        char* w = &out[start];
+        size_t i = 0;
+        if (pending_ != 0 && n > 0) {
+            i = emit(pending_, static_cast<unsigned char>(p[0]), w) - 1;
+            pending_ = 0;
+        }
+        while (i < n) {
+            size_t run = asciiPrefix(p + i, n - i);
+            memcpy(w, p + i, run);
+            w += run;
+            i += run;
+            if (i >= n) break;
+            unsigned char lead = static_cast<unsigned char>(p[i]);
+            if (i + 1 >= n) {
+                pending_ = lead;  // ַһ
+                break;
+            }
+            i += emit(lead, static_cast<unsigned char>(p[i + 1]), w);
+        }
+        out.resize(w - out.data());
+    }
+
+    // İַ
+    void finish(std::string& out) {
+        if (pending_ != 0) out += "\xEF\xBF\xBD";
+        pending_ = 0;
+    }
+
+private:
+    // ĵֽ޴ַβֽ ASCII ʱֻֽڣ̵ ASCII
+    size_t emit(unsigned char lead, unsigned char trail, char*& w) {
+        uint32_t cp = gbkToUnicode(lead, trail);
+        w = writeUtf8(w, cp == 0 ? 0xFFFD : cp);
+        return cp == 0 && trail < 0x80 ? 1 : 2;
+    }
+
+    unsigned char pending_ = 0;
+};
+
+class Utf8ToGbk {
+public:
+    void feed(std::string_view in, std::string& out) {
+        const char* p = in.data();
+        size_t n = in.size();
+        size_t start = out.size();
+        out.resize(start + n + 1);  // GBK  UTF-8 Ӳַ '?'
+        char* w = &out[start];
+        size_t i = 0;
+        // ȲȫһĩβĲַ
+        if (pendingSize_ > 0) {
+            size_t need = sequenceLength(static_cast<unsigned char>(pending_[0]));
+            while (pendingSize_ < need && i < n && isContinuation(p[i])) pending_[pendingSize_++] = p[i++];
+            if (pendingSize_ == need) {
+                emit(pending_, need, w);
+                pendingSize_ = 0;
+            } else if (i < n) {
+                *w++ = '?';  // ֽڴ
+                pendingSize_ = 0;
+            }
+        }
+        while (i < n) {
+            size_t run = asciiPrefix(p + i, n - i);
+            memcpy(w, p + i, run);
+            w += run;
+            i += run;
+            if (i >= n) break;
+            size_t need = sequenceLength(static_cast<unsigned char>(p[i]));
+            if (need > 1 && i + need > n) {
+                bool partial = true;
+                for (size_t k = i + 1; k < n; ++k) partial = partial && isContinuation(p[k]);
+                if (partial) {
+                    // ַһ
+                    pendingSize_ = n - i;
+                    memcpy(pending_, p + i, pendingSize_);
+                    break;
+                }
+            }
+            i += emit(p + i, need == 0 ? 1 : need, w);
+        }
+        out.resize(w - out.data());
+    }
+
+    void finish(std::string& out) {
+        if (pendingSize_ > 0) out += '?';
+        pendingSize_ = 0;
+    }
+
+private:
+    static bool isContinuation(char c) { return (static_cast<unsigned char>(c) & 0xC0) == 0x80; }
+
+    static size_t sequenceLength(unsigned char c) {
+        if (c < 0x80) return 1;
+        if (c >= 0xC2 && c <= 0xDF) return 2;
+        if (c >= 0xE0 && c <= 0xEF) return 3;
+        if (c >= 0xF0 && c <= 0xF4) return 4;
+        return 0;  // Ƿֽ
+    }
+
+    // תһضϵķǷУĵֽ
+    size_t emit(const char* s, size_t len, char*& w) {
+        const unsigned char* u = reinterpret_cast<const unsigned char*>(s);
+        size_t need = sequenceLength(u[0]);
+        if (need == 0 || len < need) {
+            *w++ = '?';
+            return 1;
+        }
+        uint32_t cp = u[0] & (0x7F >> need);
+        for (size_t k = 1; k < need; ++k) {
+            if (!isContinuation(s[k])) {
+                *w++ = '?';
+                return k;
+            }
+            cp = (cp << 6) | (u[k] & 0x3F);
+        }
+        uint16_t g = unicodeToGbk(cp);
+        if (g == 0) {
+            *w++ = '?';
+        } else {
+            *w++ = static_cast<char>(g >> 8);
+            *w++ = static_cast<char>(g & 0xFF);
+        }
+        return need;
+    }
+
+    char pending_[4];
+    size_t pendingSize_ = 0;
+};
+
+// ͷжϱ룺 UTF-8 BOM ȫǺϷ UTF-8 ֽʱΪ UTF-8
+// Ϊ GBKûз ASCII ֽʱΪ ASCIIĩβضϵַж
+inline TextEncoding detectEncoding(std::string_view sample) {
+    if (sample.size() >= 3 && sample.compare(0, 3, "\xEF\xBB\xBF") == 0) return TextEncoding::UTF8;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(sample.data());
+    size_t n = sample.size();
+    bool multibyte = false;
+    size_t i = asciiPrefix(sample.data(), n);
+    while (i < n) {
+        unsigned char c = p[i];
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+        size_t need = c >= 0xC2 && c <= 0xDF ? 2 : c >= 0xE0 && c <= 0xEF ? 3 : c >= 0xF0 && c <= 0xF4 ? 4 : 0;
+        if (need == 0) return TextEncoding::GBK;
+        if (i + need > n) break;
+        for (size_t k = 1; k < need; ++k) {
+            if ((p[i + k] & 0xC0) != 0x80) return TextEncoding::GBK;
+        }
+        multibyte = true;
+        i += need;
+    }
+    return multibyte ? TextEncoding::UTF8 : TextEncoding::ASCII;
+}
+
+const size_t kEncodingSampleBytes = 64 * 1024;  // Զʶʱֽ
+const size_t kTranscodeChunkBytes = 64 * 1024;  // ֿתĿС
+
+//  UTF-8 ıֿת GBKȥ BOMд out
+inline void utf8ToGbk(std::string_view text, std::string& out) {
+    if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) text.remove_prefix(3);
+    out.clear();
+    out.reserve(text.size());
+    Utf8ToGbk conv;
+    for (size_t pos = 0; pos < text.size(); pos += kTranscodeChunkBytes) {
+        conv.feed(text.substr(pos, kTranscodeChunkBytes), out);
+    }
+    conv.finish(out);
+}
+
+inline void gbkToUtf8(std::string_view text, std::string& out) {
+    out.clear();
+    out.reserve(text.size() + text.size() / 2);
+    GbkToUtf8 conv;
+    for (size_t pos = 0; pos < text.size(); pos += kTranscodeChunkBytes) {
+        conv.feed(text.substr(pos, kTranscodeChunkBytes), out);
+    }
+    conv.finish(out);
+}
+
+#endif  // TEXT_ENCODING_H
@@ -0,0 +1,104 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Ĭ߳CPU ȡʱ˻ 1
+inline unsigned defaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// ̶С̳߳أύ˳ȡִ
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = defaultThreadCount()) {
+        threads = std::max(1u, threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push(std::move(task));
+            ++pending_;
+        }
+        wake_.notify_one();
+    }
+
+    // ȴύ
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;  // stopping_ ûʣ
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) idle_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+};
+
+//  [0, n) ִָ߳ fn(i)ÿ̶̬߳ȡһ±
+template <typename F>
+void parallelFor(size_t n, F&& fn, unsigned threads = defaultThreadCount()) {
+    threads = static_cast<unsigned>(std::min<size_t>(std::max(1u, threads), n));
+    if (threads <= 1) {
+        for (size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < n; i = next++) fn(i);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();  // ǰ߳Ҳ
+    for (auto& t : pool) t.join();
+}
+
+#endif  // THREAD_POOL_H
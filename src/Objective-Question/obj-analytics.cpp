@@ -0,0 +1,335 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <cstdio>
+
+#include "../Common/bank-set.h"
+#include "../Common/console-encoding.h"
+#include "../Common/dedup-index.h"
+#include "../Common/review-scheduler.h"
+#include "../Common/session-telemetry.h"
+#include "../Common/thread-pool.h"
+
+using namespace std;
+
+// Ȿȡ obj-quiz д obj-answers.txt༶ĶⱾÿ GB
+// ͳÿĴʹʡѡ͸͵ȷʣѵ N д obj-quiz ֱӼص⡣
+// ÷obj-analytics [Ȿ...] [--attempts Ự־.qtl...] [--bank ...] [--top N] [--hardest N] [--out .txt]
+//   ָⱾʱȡǰĿ¼ obj-answers.txt
+//   --attemptsobj-quiz ĻỰ־obj-telemetry.qtl¼ÿʹʣ
+//               Ȿֻ¼⣬ָʱֻܰ
+//   --bankļ֧ͨȷδĿͣʹ͵ȷ
+//   --topʾĬ 20--hardestдѵ N ⣨Ĭ --top ֵ
+//   --outĿļĬ obj-hardest.txt
+//   --chunkÿζֽMBĬ 64ݰ #END гɶβнڴռⱾС޹
+
+// һͳƣĿָƻ
+struct QuestionStats {
+    QuestionType type = QuestionType::JUDGE;
+    string text;         // ʽԭĿдĿʱʹ
+    string title;        // ɵһ
+    vector<string> options;
+    uint64_t wrong = 0;  // ⱾеĴ
+    uint64_t attempts = 0, correct = 0;  // Ự־е
+    unordered_map<uint32_t, uint64_t> confusion;  // (ȷѡ << 8 | ѡѡ) -> 
+
+    // ⱾỰ־ܲȫӦֻ¼˲ֻỰȡнϴ
+    uint64_t errors() const { return max(wrong, attempts - min(attempts, correct)); }
+    uint64_t tries() const { return max(attempts, errors()); }
+};
+
+using StatsMap = unordered_map<uint64_t, QuestionStats>;
+
+// һĴ¼ #END нβۼӵ stats
+void parseRecords(string_view text, StatsMap& stats) {
+    enum State { NONE, IN_QUESTION, IN_OPTIONS, IN_USER, IN_CORRECT } state = NONE;
+    vector<string_view> stem, options, userLines, correctLines;
+    QuestionType type = QuestionType::JUDGE;
+    bool open = false;
+
+    auto finish = [&]() {
+        if (!open || !isObjective(type) || stem.empty()) return;
+        Question q;
+        q.type = type;
+        q.question = {stem.data(), stem.size()};
+        q.options = {options.data(), options.size()};
+        string_view correctLine = correctLines.empty() ? string_view() : correctLines[0];
+        string_view userLine = userLines.empty() ? string_view() : userLines[0];
+        uint32_t user = 0;
+        for (size_t i = 0; i < options.size() && i < 32; ++i) {
+            if (answerLineHas(correctLine, options[i])) q.correctAnswers |= 1u << i;
+            if (answerLineHas(userLine, options[i])) user |= 1u << i;
+        }
+
+        QuestionStats& s = stats[questionFingerprint(q)];
+        if (s.wrong++ == 0) {
+            s.type = type;
+            s.title = string(stem[0]);
+            string& t = s.text;
+            t = "#" + string(questionTypeName(type)) + "\n";
+            for (string_view line : stem) (t += line) += "\n";
+            t += "#OPTIONS\n";
+            for (string_view o : options) {
+                (t += o) += "\n";
+                s.options.emplace_back(o);
+            }
+            t += "#CORRECT\n";
+            for (uint32_t m = q.correctAnswers; m; m &= m - 1) {
+                if (t.back() != '\n') t += ",";
+                t += to_string(lowestBit(m) + 1);
+            }
+            t += "\n#END\n\n";
+        }
+        // ÿ©ѡȷѡÿѡѡһ
+        uint32_t missed = q.correctAnswers & ~user, extra = user & ~q.correctAnswers;
+        for (uint32_t m = missed; m; m &= m - 1) {
+            for (uint32_t e = extra; e; e &= e - 1) ++s.confusion[uint32_t(lowestBit(m)) << 8 | lowestBit(e)];
+        }
+    };
+
+    while (!text.empty()) {
+        size_t nl = text.find('\n');
+        string_view line = text.substr(0, nl);
+        text = nl == string_view::npos ? string_view() : text.substr(nl + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        string_view marker = trimLineEnd(line);
+        if (isQuestionMarker(marker)) {
+            parseQuestionType(marker.substr(1), type);
+            open = true;
+            stem.clear();
+            options.clear();
+            userLines.clear();
+            correctLines.clear();
+            state = IN_QUESTION;
+        } else if (marker == "#OPTIONS") {
+            state = IN_OPTIONS;
+        } else if (marker == "#USER_ANSWER") {
+            state = IN_USER;
+        } else if (marker == "#CORRECT_ANSWER") {
+            state = IN_CORRECT;
+        } else if (marker == "#END") {
+            finish();
+            open = false;
+            state = NONE;
+        } else if (!line.empty()) {
+            if (state == IN_QUESTION) stem.push_back(line);
+            else if (state == IN_OPTIONS) options.push_back(stripOptionLabel(line));
+            else if (state == IN_USER) userLines.push_back(line);
+            else if (state == IN_CORRECT) correctLines.push_back(line);
+        }
+    }
+}
+
+void mergeStats(StatsMap& into, StatsMap& from) {
+    for (auto& [fp, s] : from) {
+        auto it = into.find(fp);
+        if (it == into.end()) {
+            into.emplace(fp, move(s));
+            continue;
+        }
+        it->second.wrong += s.wrong;
+        for (const auto& [pair, n] : s.confusion) it->second.confusion[pair] += n;
+    }
+}
+
+// text һ #END ֮λãûʱ 0
+size_t lastRecordEnd(string_view text) {
+    for (size_t pos = text.size(); pos > 0;) {
+        size_t found = text.rfind("#END", pos - 1);
+        if (found == string_view::npos) return 0;
+        size_t eol = text.find('\n', found);
+        bool lineStart = found == 0 || text[found - 1] == '\n';
+        if (lineStart && eol != string_view::npos && trimLineEnd(text.substr(found, eol - found)) == "#END") return eol + 1;
+        pos = found;
+    }
+    return 0;
+}
+
+// ֿȡⱾÿһ #END ضϣµĲһ飩ٰ #END гɶβн
+bool scanLog(const string& path, size_t chunkBytes, unsigned threads, StatsMap& stats, uint64_t& bytes) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+    string block, carry;
+    vector<char> buf(chunkBytes);
+    while (in) {
+        in.read(buf.data(), static_cast<streamsize>(buf.size()));
+        size_t got = static_cast<size_t>(in.gcount());
+        if (got == 0) break;
+        bytes += got;
+        block.swap(carry);
+        block.append(buf.data(), got);
+        size_t end = in ? lastRecordEnd(block) : block.size();
+        carry.assign(block, end, string::npos);
+        block.resize(end);
+
+        // Ŀ곤зֵ㣬ÿζһ¼Ŀͷʼ
+        vector<size_t> cuts = {0};
+        for (unsigned t = 1; t < threads; ++t) {
+            size_t target = max(cuts.back(), block.size() * t / threads);
+            size_t cut = lastRecordEnd(string_view(block).substr(0, target));
+            if (cut > cuts.back()) cuts.push_back(cut);
+        }
+        cuts.push_back(block.size());
+        vector<StatsMap> partial(cuts.size() - 1);
+        parallelFor(partial.size(), [&](size_t i) {
+            parseRecords(string_view(block).substr(cuts[i], cuts[i + 1] - cuts[i]), partial[i]);
+        }, threads);
+        for (auto& p : partial) mergeStats(stats, p);
+    }
+    if (!carry.empty()) parseRecords(carry, stats);
+    return true;
+}
+
+string percent(uint64_t part, uint64_t whole) {
+    if (whole == 0) return "-";
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%.1f%%", part * 100.0 / whole);
+    return buf;
+}
+
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
+    vector<string> logs, attemptLogs, bankPatterns;
+    size_t top = 20, hardest = 0, chunkMb = 64;
+    string outFile = "obj-hardest.txt";
+    vector<string>* list = &logs;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--attempts") list = &attemptLogs;
+        else if (arg == "--bank") list = &bankPatterns;
+        else if (arg == "--top" && i + 1 < argc) top = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--hardest" && i + 1 < argc) hardest = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--out" && i + 1 < argc) outFile = argv[++i];
+        else if (arg == "--chunk" && i + 1 < argc) chunkMb = max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+        else if (arg.compare(0, 2, "--") == 0) list = &logs;
+        else list->push_back(arg);
+    }
+    if (logs.empty()) logs.push_back("obj-answers.txt");
+    if (hardest == 0) hardest = top;
+
+    auto start = chrono::steady_clock::now();
+    StatsMap stats;
+    uint64_t bytes = 0;
+    for (const auto& log : logs) {
+        if (!scanLog(log, chunkMb << 20, defaultThreadCount(), stats, bytes)) cerr << "Unable to read " << log << "\n";
+    }
+    uint64_t wrong = 0;
+    for (const auto& [fp, s] : stats) wrong += s.wrong;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("Read %zu logs (%.1f MB) in %.2f s: %llu wrong answers on %zu questions\n", logs.size(), bytes / 1e6,
+           seconds, static_cast<unsigned long long>(wrong), stats.size());
+
+    // Ự־еÿֻͳ obj-quiz ĻỰеĿȫ
+    unordered_map<uint64_t, QuestionType> typeOf;
+    if (!bankPatterns.empty()) {
+        BankSet banks;
+        loadBanks(expandBankPatterns(bankPatterns), banks);
+        for (const auto& q : banks.questions) typeOf.emplace(questionFingerprint(q), q.type);
+    }
+    uint64_t answers = 0;
+    unordered_map<uint64_t, pair<uint64_t, uint64_t>> attemptsOnly;  // ûд¼Ŀ(, )
+    for (const auto& file : attemptLogs) {
+        size_t chunks = readTelemetryLog(file, [&](const TelemetryChunkHeader& h, const TelemetryEvent* e, size_t n) {
+            if (h.program != 0) return;
+            for (size_t i = 0; i < n; ++i) {
+                if (e[i].phase != static_cast<uint8_t>(TelemetryPhase::ANSWER) || e[i].fingerprint == 0) continue;
+                auto it = stats.find(e[i].fingerprint);
+                if (it != stats.end()) {
+                    ++it->second.attempts;
+                    it->second.correct += e[i].result;
+                } else {
+                    auto& counts = attemptsOnly[e[i].fingerprint];
+                    ++counts.first;
+                    counts.second += e[i].result;
+                }
+                ++answers;
+            }
+        });
+        if (chunks == 0) cerr << "No telemetry in " << file << "\n";
+    }
+    if (!attemptLogs.empty()) printf("Attempts from %zu session logs: %llu answers\n", attemptLogs.size(),
+                                     static_cast<unsigned long long>(answers));
+
+    // ͣⱾеĴԼỰ־еʹԴ
+    struct TypeStats {
+        uint64_t wrong = 0, attempts = 0, correct = 0;
+    };
+    vector<TypeStats> types(kQuestionTypeCount + 1);  // һδ֪Ŀ
+    for (auto& [fp, s] : stats) {
+        TypeStats& t = types[static_cast<size_t>(s.type)];
+        t.wrong += s.wrong;
+        t.attempts += s.attempts;
+        t.correct += s.correct;
+    }
+    for (const auto& [fp, counts] : attemptsOnly) {
+        auto it = typeOf.find(fp);
+        TypeStats& t = types[it == typeOf.end() ? kQuestionTypeCount : static_cast<size_t>(it->second)];
+        t.attempts += counts.first;
+        t.correct += counts.second;
+    }
+    printf("\n%-12s %12s %12s %10s\n", "type", "wrong", "attempts", "accuracy");
+    for (size_t i = 0; i < types.size(); ++i) {
+        const TypeStats& t = types[i];
+        if (t.wrong == 0 && t.attempts == 0) continue;
+        string name = i < kQuestionTypeCount ? string(kQuestionTypeInfo[i].name) : "unknown";
+        printf("%-12s %12llu %12llu %10s\n", name.c_str(), static_cast<unsigned long long>(t.wrong),
+               static_cast<unsigned long long>(t.attempts), percent(t.correct, t.attempts).c_str());
+    }
+
+    // ѶȣƽĴ ( + 1) / ( + 2)ûлỰ־ʱڴ
+    vector<const QuestionStats*> ranked;
+    for (const auto& [fp, s] : stats) ranked.push_back(&s);
+    auto hardness = [](const QuestionStats* s) { return (s->errors() + 1.0) / (s->tries() + 2.0); };
+    sort(ranked.begin(), ranked.end(), [&](const QuestionStats* a, const QuestionStats* b) {
+        double ha = hardness(a), hb = hardness(b);
+        return ha != hb ? ha > hb : (a->wrong != b->wrong ? a->wrong > b->wrong : a->title < b->title);
+    });
+    printf("\n%4s %10s %10s %8s  %-12s %s\n", "rank", "wrong", "attempts", "error", "type", "question");
+    for (size_t i = 0; i < ranked.size() && i < top; ++i) {
+        const QuestionStats& s = *ranked[i];
+        char row[96];
+        snprintf(row, sizeof(row), "%4zu %10llu %10llu %8s  %-12s ", i + 1, static_cast<unsigned long long>(s.wrong),
+                 static_cast<unsigned long long>(s.attempts),
+                 s.attempts ? percent(s.errors(), s.tries()).c_str() : "-", string(questionTypeName(s.type)).c_str());
+        cout << row << s.title << "\n";
+    }
+
+    // ѡȷѡĸѡ
+    struct Confusion {
+        uint64_t count;
+        const QuestionStats* question;
+        uint32_t pair;
+    };
+    vector<Confusion> confusions;
+    for (const auto& [fp, s] : stats) {
+        for (const auto& [pair, n] : s.confusion) confusions.push_back({n, &s, pair});
+    }
+    size_t shown = min(top, confusions.size());
+    partial_sort(confusions.begin(), confusions.begin() + shown, confusions.end(),
+                 [](const Confusion& a, const Confusion& b) { return a.count > b.count; });
+    if (shown > 0) cout << "\nMost confused options (correct -> chosen):\n";
+    for (size_t i = 0; i < shown; ++i) {
+        const Confusion& c = confusions[i];
+        const auto& options = c.question->options;
+        char count[32];
+        snprintf(count, sizeof(count), "%10llu  ", static_cast<unsigned long long>(c.count));
+        cout << count << c.question->title << "\n            " << options[c.pair >> 8] << "  ->  "
+             << options[c.pair & 0xFF] << "\n";
+    }
+
+    // ѵĿд⣬obj-quiz ֱӼ
+    ofstream out(outFile, ios::binary);
+    if (!out) {
+        cerr << "Unable to write " << outFile << "\n";
+        return 1;
+    }
+    size_t written = 0;
+    for (; written < ranked.size() && written < hardest; ++written) out << ranked[written]->text;
+    cout << "\nWrote the " << written << " hardest questions to " << outFile << "\n";
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <cstdio>
+
+#include "../Common/answer-journal.h"
+#include "../Common/bank-set.h"
+#include "../Common/console-encoding.h"
+#include "../Common/dedup-index.h"
+#include "../Common/item-response.h"
+#include "../Common/session-telemetry.h"
+#include "../Common/thread-pool.h"
+
+using namespace std;
+
+// ѶУ׼ȡһ༶¼ÿѧһ obj-attempts.qjlҲ obj-telemetry.qtl Ự־
+//  2PL ĿӦģ͹ÿѶȺֶԼÿѧдУ׼ļ
+// obj-quiz --adaptive Ӧ⡣ obj-analytics ĴʲͬѶѾ۳˴ѧˮƽߵ͵Ӱ졣
+// ÷obj-calibrate ¼... [--bank ...] [--out obj-calibration.txt] [--abilities .csv] [--top N]
+//                     [--max-iterations N] [--tolerance x]
+//   ÿ¼ļΪһѧ.qtl ļֻȡ obj-quiz Ựе
+//   --bankļ֧ͨڱʾ
+//   --outУ׼ļĬ obj-calibration.txt--abilitiesÿѧд CSV
+//   --topʾѵ N ⣨Ĭ 20--max-iterations--toleranceEM ֵ
+
+double elapsedMs(chrono::steady_clock::time_point& last) {
+    auto now = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(now - last).count();
+    last = now;
+    return ms;
+}
+
+// һ¼ļе(Ŀָ, Ƿ)
+bool readAttempts(const string& path, vector<pair<uint64_t, bool>>& out) {
+    bool telemetryLog = path.size() >= 4 && path.compare(path.size() - 4, 4, ".qtl") == 0;
+    if (telemetryLog) {
+        size_t chunks = readTelemetryLog(path, [&](const TelemetryChunkHeader& h, const TelemetryEvent* e, size_t n) {
+            if (h.program != 0) return;
+            for (size_t i = 0; i < n; ++i) {
+                if (e[i].phase != static_cast<uint8_t>(TelemetryPhase::ANSWER) || e[i].fingerprint == 0) continue;
+                out.push_back({e[i].fingerprint, e[i].result != 0});
+            }
+        });
+        return chunks > 0;
+    }
+    size_t records = readJournal(path, [&](const JournalEntry& entry, string_view) {
+        if (isObjective(static_cast<QuestionType>(entry.type))) out.push_back({entry.fingerprint, entry.correct != 0});
+    });
+    return records > 0;
+}
+
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
+    vector<string> logs, bankPatterns;
+    string outFile = "obj-calibration.txt", abilityFile;
+    size_t top = 20;
+    CalibrationOptions options;
+    vector<string>* list = &logs;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--bank") list = &bankPatterns;
+        else if (arg == "--out" && i + 1 < argc) outFile = argv[++i];
+        else if (arg == "--abilities" && i + 1 < argc) abilityFile = argv[++i];
+        else if (arg == "--top" && i + 1 < argc) top = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--max-iterations" && i + 1 < argc) options.maxIterations = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--tolerance" && i + 1 < argc) options.tolerance = strtod(argv[++i], nullptr);
+        else if (arg.compare(0, 2, "--") == 0) {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        } else list->push_back(arg);
+    }
+    if (logs.empty() || options.maxIterations == 0) {
+        cerr << "Usage: obj-calibrate attempts... [--bank bank...] [--out obj-calibration.txt] [--abilities file.csv]"
+                " [--top N] [--max-iterations N] [--tolerance x]\n";
+        return 1;
+    }
+
+    // ļжȡĿŰָƵһγֵ˳
+    auto last = chrono::steady_clock::now();
+    vector<vector<pair<uint64_t, bool>>> perLearner(logs.size());
+    vector<char> readable(logs.size());
+    parallelFor(logs.size(), [&](size_t l) { readable[l] = readAttempts(logs[l], perLearner[l]); });
+    unordered_map<uint64_t, uint32_t> itemOf;
+    vector<uint64_t> fingerprints;
+    vector<Attempt> attempts;
+    for (size_t l = 0; l < logs.size(); ++l) {
+        if (!readable[l]) cerr << "No attempts in " << logs[l] << "\n";
+        for (const auto& [fp, correct] : perLearner[l]) {
+            auto [it, added] = itemOf.emplace(fp, static_cast<uint32_t>(fingerprints.size()));
+            if (added) fingerprints.push_back(fp);
+            attempts.push_back({static_cast<uint32_t>(l), it->second, correct});
+        }
+        vector<pair<uint64_t, bool>>().swap(perLearner[l]);
+    }
+    if (attempts.empty()) {
+        cerr << "No attempts found\n";
+        return 1;
+    }
+    double readMs = elapsedMs(last);
+    printf("Read %zu attempts by %zu learners on %zu questions in %.1f ms\n", attempts.size(), logs.size(),
+           fingerprints.size(), readMs);
+
+    ResponseMatrix matrix = buildResponseMatrix(logs.size(), fingerprints.size(), attempts);
+    Calibration calibration = calibrate(matrix, options);
+    double calibrateMs = elapsedMs(last);
+    printf("Calibrated in %zu EM iterations (%s) in %.1f ms, log-likelihood %.1f\n", calibration.iterations,
+           calibration.converged ? "converged" : "not converged", calibrateMs, calibration.logLikelihood);
+
+    vector<ItemCalibration> items(fingerprints.size());
+    for (size_t j = 0; j < items.size(); ++j) {
+        items[j].params = calibration.items[j];
+        for (uint32_t k = matrix.itemStart[j]; k < matrix.itemStart[j + 1]; ++k) {
+            items[j].tries += matrix.itemTries[k];
+            items[j].correct += matrix.itemCorrect[k];
+        }
+    }
+    if (!writeCalibration(outFile, fingerprints, items, logs.size(), attempts.size())) {
+        cerr << "Unable to write " << outFile << "\n";
+        return 1;
+    }
+    printf("Calibration written to %s\n", outFile.c_str());
+
+    if (!abilityFile.empty()) {
+        string csv = "learner,attempts,correct,ability,se\n";
+        char buf[64];
+        for (size_t l = 0; l < logs.size(); ++l) {
+            uint32_t tries = 0, correct = 0;
+            for (uint32_t k = matrix.learnerStart[l]; k < matrix.learnerStart[l + 1]; ++k) {
+                tries += matrix.learnerTries[k];
+                correct += matrix.learnerCorrect[k];
+            }
+            snprintf(buf, sizeof(buf), ",%u,%u,%.3f,%.3f\n", tries, correct, calibration.ability[l],
+                     calibration.abilitySe[l]);
+            (csv += logs[l]) += buf;
+        }
+        ofstream out(abilityFile, ios::binary | ios::trunc);
+        out.write(csv.data(), csv.size());
+        if (!out) {
+            cerr << "Unable to write " << abilityFile << "\n";
+            return 1;
+        }
+        printf("Learner abilities written to %s\n", abilityFile.c_str());
+    }
+
+    // ѵļ⣺ѶȴӸߵͣ --bank ָ
+    unordered_map<uint64_t, const Question*> questionOf;
+    BankSet banks;
+    if (!bankPatterns.empty()) {
+        loadBanks(expandBankPatterns(bankPatterns), banks);
+        for (const auto& q : banks.questions) questionOf.emplace(questionFingerprint(q), &q);
+    }
+    vector<uint32_t> order(items.size());
+    for (size_t j = 0; j < order.size(); ++j) order[j] = static_cast<uint32_t>(j);
+    size_t shown = min(top, order.size());
+    partial_sort(order.begin(), order.begin() + shown, order.end(),
+                 [&](uint32_t a, uint32_t b) { return items[a].params.b > items[b].params.b; });
+    printf("\n%4s %8s %8s %8s %8s  %-12s %s\n", "rank", "diff", "discr", "attempts", "correct", "type", "question");
+    for (size_t i = 0; i < shown; ++i) {
+        const ItemCalibration& item = items[order[i]];
+        auto it = questionOf.find(fingerprints[order[i]]);
+        const Question* q = it == questionOf.end() ? nullptr : it->second;
+        char row[96];
+        snprintf(row, sizeof(row), "%4zu %8.2f %8.2f %8u %7.1f%%  %-12s ", i + 1, item.params.b, item.params.a,
+                 item.tries, item.correct * 100.0 / max(item.tries, 1u),
+                 q ? string(questionTypeName(q->type)).c_str() : "-");
+        cout << row;
+        if (q && !q->question.empty()) {
+            cout << q->question[0] << "\n";
+        } else {
+            snprintf(row, sizeof(row), "%016llx", static_cast<unsigned long long>(fingerprints[order[i]]));
+            cout << row << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "../Common/bank-set.h"
+#include "../Common/console-encoding.h"
+#include "../Common/dedup-index.h"
+#include "../Common/near-duplicate.h"
+#include "../Common/thread-pool.h"
+
+using namespace std;
+
+// ࣺһ⣨ java1 ~ java7javaselfjava-tot ϲҳǲͬĿ
+// ƶȷдļobj-quiz --clusters ʱÿֻһȫͬڼʱѾָȥء
+// ÷obj-cluster ... [--threshold 0.7] [--rows R] [--out obj-clusters.txt] [--top N]
+//   --thresholdƬμϵƶȣJaccard0 ~ 1ڴֵʱΪͬһĲͬ汾Ĭ 0.7
+//   --rowsLSH ÿεǩ128 ԼĬϰֵԶѡԽСѡԽ࣬©ĸԽС
+//   --outļĬ obj-clusters.txt--topʾ N 飨Ĭ 10
+
+double elapsedMs(chrono::steady_clock::time_point& last) {
+    auto now = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(now - last).count();
+    last = now;
+    return ms;
+}
+
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
+    vector<string> patterns;
+    string outFile = "obj-clusters.txt";
+    double threshold = 0.7;
+    size_t rows = 0, top = 10;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threshold" && i + 1 < argc) threshold = strtod(argv[++i], nullptr);
+        else if (arg == "--rows" && i + 1 < argc) rows = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--out" && i + 1 < argc) outFile = argv[++i];
+        else if (arg == "--top" && i + 1 < argc) top = strtoull(argv[++i], nullptr, 10);
+        else if (arg.compare(0, 2, "--") != 0) patterns.push_back(arg);
+        else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (patterns.empty() || threshold <= 0 || threshold > 1) {
+        cerr << "Usage: obj-cluster bank... [--threshold 0.7] [--rows R] [--out obj-clusters.txt] [--top N]\n";
+        return 1;
+    }
+    if (rows == 0) rows = lshRowsFor(threshold);
+    if (kMinHashSize % rows != 0) {
+        cerr << "--rows must divide " << kMinHashSize << "\n";
+        return 1;
+    }
+
+    auto last = chrono::steady_clock::now();
+    BankSet banks;
+    loadBanks(expandBankPatterns(patterns), banks);
+    const vector<Question>& questions = banks.questions;
+    size_t n = questions.size();
+    double loadMs = elapsedMs(last);
+
+    // ÿǩţ̸߳дԼһ
+    vector<uint32_t> signatures(n * kMinHashSize);
+    vector<char> valid(n);
+    MinHasher hasher;
+    parallelFor(n, [&](size_t i) { valid[i] = hasher.sign(questions[i], &signatures[i * kMinHashSize]); });
+    double signMs = elapsedMs(last);
+
+    size_t candidates = 0;
+    auto pairs = findSimilarPairs(signatures, valid, threshold, rows, &candidates);
+    double lshMs = elapsedMs(last);
+    auto clusters = clusterPairs(n, pairs);
+
+    vector<vector<uint64_t>> fingerprints(clusters.size());
+    size_t clustered = 0;
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        for (uint32_t idx : clusters[c]) fingerprints[c].push_back(questionFingerprint(questions[idx]));
+        clustered += clusters[c].size();
+    }
+    if (!writeClusters(outFile, fingerprints, threshold)) {
+        cerr << "Unable to write " << outFile << "\n";
+        return 1;
+    }
+    double clusterMs = elapsedMs(last);
+
+    printf("Loaded %zu questions from %zu banks in %.1f ms\n", n, banks.files.size(), loadMs);
+    printf("MinHash signatures (%zu values) in %.1f ms\n", kMinHashSize, signMs);
+    printf("LSH %zu bands x %zu rows: %zu candidate pairs, %zu similar pairs (threshold %.2f) in %.1f ms\n",
+           kMinHashSize / rows, rows, candidates, pairs.size(), threshold, lshMs);
+    printf("%zu clusters covering %zu questions written to %s in %.1f ms\n", clusters.size(), clustered,
+           outFile.c_str(), clusterMs);
+
+    // ļ飺ÿʾԴ⡢ڵһĹƶȺɵһ
+    vector<size_t> order(clusters.size());
+    for (size_t c = 0; c < order.size(); ++c) order[c] = c;
+    size_t shown = min(top, order.size());
+    partial_sort(order.begin(), order.begin() + shown, order.end(),
+                 [&](size_t a, size_t b) { return clusters[a].size() > clusters[b].size(); });
+    for (size_t k = 0; k < shown; ++k) {
+        const auto& cluster = clusters[order[k]];
+        cout << "\nCluster " << k + 1 << " (" << cluster.size() << " questions)\n";
+        const uint32_t* first = &signatures[size_t(cluster[0]) * kMinHashSize];
+        for (uint32_t idx : cluster) {
+            const Question& q = questions[idx];
+            char similarity[16];
+            snprintf(similarity, sizeof(similarity), "%.2f",
+                     signatureSimilarity(first, &signatures[size_t(idx) * kMinHashSize]));
+            cout << "  " << similarity << "  [" << questionTypeName(q.type) << "] " << banks.files[q.source] << ": "
+                 << (q.question.empty() ? string_view() : q.question[0]) << "\n";
+        }
+    }
+    return 0;
+}
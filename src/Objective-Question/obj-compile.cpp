@@ -0,0 +1,47 @@
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "../Common/compiled-bank.h"
+#include "../Common/console-encoding.h"
+
+using namespace std;
+
+// һ .txt ͬ .qbk
+bool compileFile(string filename) {
+    if (filename.size() < 4 || filename.substr(filename.size() - 4) != ".txt") {
+        filename += ".txt";
+    }
+    QuestionBank bank;
+    if (!loadTextBank(filename, bank)) {
+        return false;
+    }
+
+    string outPath = compiledBankPath(filename);
+    if (!writeCompiledBank(bank, outPath)) {
+        cerr << "޷д " << outPath << "\n";
+        return false;
+    }
+    cout << filename << " -> " << outPath << "" << bank.questions.size() << " ⣩\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
+    vector<string> files;
+    for (int i = 1; i < argc; ++i) {
+        files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        string filename;
+        cout << "Ҫļ";
+        getline(cin, filename);
+        files.push_back(filename);
+    }
+
+    int failed = 0;
+    for (const auto& filename : files) {
+        if (!compileFile(filename)) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
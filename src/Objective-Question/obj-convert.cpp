@@ -0,0 +1,125 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <filesystem>
+
+#include "../Common/console-encoding.h"
+#include "../Common/text-encoding.h"
+
+using namespace std;
+
+// תGBK <-> UTF-8дļڴ
+// ÷obj-convert [--to utf8|gbk] [-o ļ] ļ...
+//   ָ --to ʱļͷʶ룬תΪһ
+//   ָ -o ʱԭתдʱļ滻
+
+//  in  from תΪ to д out
+bool transcodeStream(istream& in, ostream& out, TextEncoding from, TextEncoding to) {
+    vector<char> chunk(kTranscodeChunkBytes);
+    string converted;
+    GbkToUtf8 toUtf8;
+    Utf8ToGbk toGbk;
+    bool first = true;
+    while (in) {
+        in.read(chunk.data(), chunk.size());
+        streamsize n = in.gcount();
+        if (n <= 0) break;
+        string_view block(chunk.data(), static_cast<size_t>(n));
+        if (first && from == TextEncoding::UTF8 && block.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            block.remove_prefix(3);  // ȥ BOM
+        }
+        first = false;
+        converted.clear();
+        if (to == TextEncoding::UTF8) toUtf8.feed(block, converted);
+        else toGbk.feed(block, converted);
+        out.write(converted.data(), static_cast<streamsize>(converted.size()));
+    }
+    converted.clear();
+    if (to == TextEncoding::UTF8) toUtf8.finish(converted);
+    else toGbk.finish(converted);
+    out.write(converted.data(), static_cast<streamsize>(converted.size()));
+    return static_cast<bool>(out);
+}
+
+bool convertFile(const string& filename, const string& output, const string& target) {
+    ifstream in(filename, ios::binary);
+    if (!in) {
+        cerr << "޷ȡ " << filename << "\n";
+        return false;
+    }
+    string sample(kEncodingSampleBytes, '\0');
+    in.read(&sample[0], sample.size());
+    sample.resize(static_cast<size_t>(in.gcount()));
+    in.clear();
+    in.seekg(0);
+
+    TextEncoding from = detectEncoding(sample);
+    TextEncoding to;
+    if (target == "utf8") to = TextEncoding::UTF8;
+    else if (target == "gbk") to = TextEncoding::GBK;
+    else to = from == TextEncoding::UTF8 ? TextEncoding::GBK : TextEncoding::UTF8;
+
+    if (from == TextEncoding::ASCII || from == to) {
+        cout << filename << " " << encodingName(from) << "\n";
+        return true;
+    }
+
+    string outPath = output.empty() ? filename + ".tmp" : output;
+    {
+        ofstream out(outPath, ios::binary | ios::trunc);
+        if (!out || !transcodeStream(in, out, from, to)) {
+            cerr << "޷д " << outPath << "\n";
+            return false;
+        }
+    }
+    in.close();
+    if (output.empty()) {
+        error_code ec;
+        filesystem::rename(outPath, filename, ec);
+        if (ec) {
+            cerr << "޷滻 " << filename << "\n";
+            return false;
+        }
+    }
+    cout << filename << "" << encodingName(from) << " -> " << encodingName(to);
+    if (!output.empty()) cout << "" << output << "";
+    cout << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
+    vector<string> files;
+    string target, output;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--to" && i + 1 < argc) {
+            target = argv[++i];
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        string filename;
+        cout << "Ҫתļ";
+        getline(cin, filename);
+        files.push_back(filename);
+    }
+    if (!target.empty() && target != "utf8" && target != "gbk") {
+        cerr << "--to ֻ utf8  gbk\n";
+        return 1;
+    }
+    if (!output.empty() && files.size() > 1) {
+        cerr << "תļʱָ -o\n";
+        return 1;
+    }
+
+    int failed = 0;
+    for (const auto& filename : files) {
+        if (!convertFile(filename, output, target)) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
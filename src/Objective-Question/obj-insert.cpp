@@ -3,146 +3,249 @@
 #include <vector>
 #include <string>
 
+#include "../Common/bank-store.h"
+#include "../Common/console-encoding.h"
+
 using namespace std;
 
-struct Question {
+// ¼͹⡣Ŀͨ BankStore ׷ӵ⣬Ҳ԰Ų鿴޸ġɾ
+// ÷obj-insert [.txt] [--list | --show N | --edit N | --delete N | --compact]
+//   Ŵ 1 ʼ --list ʾͬ
+
+struct QuestionInput {  // ¼еĿдǰתı
     string type;       // ĿͣJUDGE/CHOICE/MULTICHOICE
     vector<string> question;   // ɣı
     vector<string> options;  // ѡжĬT/F
     vector<int> correctAnswers;  // ȷѡж
 };
 
-int main() {
+// һ⣻typeCHOICE  0 ͷʱһ͡Чʱ false
+bool inputQuestion(string& typeCHOICE, QuestionInput& q) {
+    // ѡĿ
+    if(typeCHOICE == "" || typeCHOICE[0] != '0'){
+        cout << "ѡĿͣ\n";
+        cout << "1. ж\n";
+        cout << "2. ѡ\n";
+        cout << "3. ѡ\n";
+        cout << "ѡ(1-3)";
+
+        getline(cin, typeCHOICE);
+    }
+
+    if (typeCHOICE[0] == '1' || typeCHOICE == "01") {
+        q.type = "JUDGE";
+        // жĬѡT/F
+        q.options = {"T", "F"};
+        cout << "жɣн\n";
+    } else if (typeCHOICE[0] == '2' || typeCHOICE[0] == '0' && typeCHOICE[1] == '2') {
+        q.type = "CHOICE";
+        int optCount = 0;
+        if(typeCHOICE.length() > 2 && typeCHOICE[2] > '2' && typeCHOICE[2] <= '9'){
+            optCount = typeCHOICE[2] - '0';
+        }
+        if(!optCount){
+            cout << "ѡ";
+            cin >> optCount;
+            cin.ignore();  // Իз
+        }
+
+        if(optCount < 2 || optCount > 9){
+            cout << "ѡ⣡\n";
+            return false;
+        }
+        
+        cout << "" << optCount << "ѡÿһУ\n";
+        for (int i = 0; i < optCount; ++i) {
+            string opt;
+            getline(cin, opt);
+            q.options.push_back(opt);
+        }
+        cout << "ѡɣн\n";
+    } else if (typeCHOICE[0] == '3' || typeCHOICE[0] == '0' && typeCHOICE[1] == '3') {
+        q.type = "MULTICHOICE";
+        int optCount = 0;
+        if(typeCHOICE.length() > 2 && typeCHOICE[2] > '2' && typeCHOICE[2] <= '9'){
+            optCount = typeCHOICE[2] - '0';
+        }
+        if(!optCount){
+            cout << "ѡ";
+            cin >> optCount;
+            cin.ignore();  // Իз
+        }
+        
+        cout << "" << optCount << "ѡÿһУ\n";
+        for (int i = 0; i < optCount; ++i) {
+            string opt;
+            getline(cin, opt);
+            q.options.push_back(opt);
+        }
+        cout << "ѡɣн\n";
+    } else {
+        cout << "Чѡ⣡\n";
+        return false;
+    }
+    
+    // ɣн
+    string line;
+    while (true) {
+        getline(cin, line);
+        if (line.empty()) {  // б
+            break;
+        }
+        q.question.push_back(line);
+    }
+    
+    // ȷ
+    cout << "ȷѡţ1ʼѡöŷָ";
+    string ansInput;
+    getline(cin, ansInput);
+    
+    // ȷ
+    size_t pos = 0;
+    while (pos < ansInput.size()) {
+        size_t comma = ansInput.find(',', pos);
+        if (comma == string::npos) {
+            q.correctAnswers.push_back(stoi(ansInput.substr(pos)) - 1);
+            break;
+        }
+        q.correctAnswers.push_back(stoi(ansInput.substr(pos, comma - pos)) - 1);
+        pos = comma + 1;
+    }
+    return true;
+}
+
+// ʽݶɣһı
+string formatQuestion(const QuestionInput& q) {
+    string text = "#" + q.type + "\n";
+    for (const auto& qLine : q.question) {
+        text += qLine + "\n";
+    }
+    text += "#OPTIONS\n";
+    for (const auto& opt : q.options) {
+        text += opt + "\n";
+    }
+    text += "#CORRECT\n";
+    for (size_t i = 0; i < q.correctAnswers.size(); ++i) {
+        if (i > 0) text += ",";
+        text += to_string(q.correctAnswers[i] + 1);
+    }
+    text += "\n#END\n";
+    return text;
+}
+
+// Ų 1 ʼת BankStore ţЧʱ -1
+long long parseNumber(const char* arg, const BankStore& store) {
+    long long n = atoll(arg);
+    if (n < 1 || !store.contains(static_cast<uint32_t>(n - 1))) {
+        cerr << " " << arg << " \n";
+        return -1;
+    }
+    return n - 1;
+}
+
+// ɵһУбʾ
+string firstStemLine(const string& text) {
+    size_t begin = text.find('\n');
+    if (begin == string::npos) return "";
+    size_t end = text.find('\n', begin + 1);
+    string line = text.substr(begin + 1, end == string::npos ? string::npos : end - begin - 1);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return line;
+}
+
+// ĿĲ--list / --show / --edit / --delete / --compact
+int runCommand(BankStore& store, const string& command, const char* arg) {
+    string text;
+    if (command == "--list") {
+        for (uint32_t id = 0; id < store.size(); ++id) {
+            if (store.read(id, text)) cout << id + 1 << ". " << firstStemLine(text) << "\n";
+        }
+        cout << " " << store.liveCount() << " \n";
+        return 0;
+    }
+    if (command == "--compact") {
+        uint64_t dead = store.deadBytes();
+        if (!store.compact()) {
+            cerr << "ѹʧܣ\n";
+            return 1;
+        }
+        cout << "ѹ " << dead << " ֽʧЧ¼\n";
+        return 0;
+    }
+    if (arg == nullptr) {
+        cerr << command << " Ҫ\n";
+        return 1;
+    }
+    long long id = parseNumber(arg, store);
+    if (id < 0 || !store.read(static_cast<uint32_t>(id), text)) return 1;
+    if (command == "--show") {
+        cout << text;
+    } else if (command == "--delete") {
+        if (!store.remove(static_cast<uint32_t>(id))) {
+            cerr << "ɾʧܣ\n";
+            return 1;
+        }
+        cout << "ɾ " << id + 1 << " \n";
+    } else if (command == "--edit") {
+        cout << "ǰĿ\n" << text << "\n";
+        QuestionInput q;
+        string typeCHOICE;
+        if (!inputQuestion(typeCHOICE, q)) return 1;
+        if (!store.put(static_cast<uint32_t>(id), formatQuestion(q))) {
+            cerr << "޸ʧܣ\n";
+            return 1;
+        }
+        cout << "޸ĵ " << id + 1 << " \n";
+    } else {
+        cerr << "δ֪ " << command << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
     string filename;
-    cout << "뱣Ŀļ";
-    getline(cin, filename);
+    if (argc > 1) {
+        filename = argv[1];
+    } else {
+        cout << "뱣Ŀļ";
+        getline(cin, filename);
+    }
     //  filename .txtβ
     if (filename.size() < 4 || filename.substr(filename.size() - 4) != ".txt") {
         filename += ".txt";
     }
-    ofstream outFile(filename, ios::app);
-    if (!outFile) {
+    BankStore store;
+    if (!store.open(filename)) {
         cerr << "޷ļд룡\n";
         return 1;
     }
+    if (argc > 2) {
+        return runCommand(store, argv[2], argc > 3 ? argv[3] : nullptr);
+    }
 
     string choice;
     string typeCHOICE = "";
     do {
-        Question q;
-        
-        // ѡĿ
-        if(typeCHOICE == "" || typeCHOICE[0] != '0'){
-            cout << "ѡĿͣ\n";
-            cout << "1. ж\n";
-            cout << "2. ѡ\n";
-            cout << "3. ѡ\n";
-            cout << "ѡ(1-3)";
-
-            getline(cin, typeCHOICE);
-        }
-
-        if (typeCHOICE[0] == '1' || typeCHOICE == "01") {
-            q.type = "JUDGE";
-            // жĬѡT/F
-            q.options = {"T", "F"};
-            cout << "жɣн\n";
-        } else if (typeCHOICE[0] == '2' || typeCHOICE[0] == '0' && typeCHOICE[1] == '2') {
-            q.type = "CHOICE";
-            int optCount = 0;
-            if(typeCHOICE.length() > 2 && typeCHOICE[2] > '2' && typeCHOICE[2] <= '9'){
-                optCount = typeCHOICE[2] - '0';
-            }
-            if(!optCount){
-                cout << "ѡ";
-                cin >> optCount;
-                cin.ignore();  // Իз
-            }
-
-            if(optCount < 2 || optCount > 9){
-                cout << "ѡ⣡\n";
-                continue;
-            }
-            
-            cout << "" << optCount << "ѡÿһУ\n";
-            for (int i = 0; i < optCount; ++i) {
-                string opt;
-                getline(cin, opt);
-                q.options.push_back(opt);
-            }
-            cout << "ѡɣн\n";
-        } else if (typeCHOICE[0] == '3' || typeCHOICE[0] == '0' && typeCHOICE[1] == '3') {
-            q.type = "MULTICHOICE";
-            int optCount = 0;
-            if(typeCHOICE.length() > 2 && typeCHOICE[2] > '2' && typeCHOICE[2] <= '9'){
-                optCount = typeCHOICE[2] - '0';
-            }
-            if(!optCount){
-                cout << "ѡ";
-                cin >> optCount;
-                cin.ignore();  // Իз
-            }
-            
-            cout << "" << optCount << "ѡÿһУ\n";
-            for (int i = 0; i < optCount; ++i) {
-                string opt;
-                getline(cin, opt);
-                q.options.push_back(opt);
-            }
-            cout << "ѡɣн\n";
-        } else {
-            cout << "Чѡ⣡\n";
+        QuestionInput q;
+        if (!inputQuestion(typeCHOICE, q)) {
             continue;
         }
-        
-        // ɣн
-        string line;
-        while (true) {
-            getline(cin, line);
-            if (line.empty()) {  // б
-                break;
-            }
-            q.question.push_back(line);
-        }
-        
-        // ȷ
-        cout << "ȷѡţ1ʼѡöŷָ";
-        string ansInput;
-        getline(cin, ansInput);
-        
-        // ȷ
-        size_t pos = 0;
-        while (pos < ansInput.size()) {
-            size_t comma = ansInput.find(',', pos);
-            if (comma == string::npos) {
-                q.correctAnswers.push_back(stoi(ansInput.substr(pos)) - 1);
-                break;
-            }
-            q.correctAnswers.push_back(stoi(ansInput.substr(pos, comma - pos)) - 1);
-            pos = comma + 1;
-        }
-        
-        // дļݶɸʽ
-        outFile << "#" << q.type << "\n";
-        for (const auto& qLine : q.question) {
-            outFile << qLine << "\n";
-        }
-        outFile << "#OPTIONS\n";
-        for (const auto& opt : q.options) {
-            outFile << opt << "\n";
-        }
-        outFile << "#CORRECT\n";
-        for (size_t i = 0; i < q.correctAnswers.size(); ++i) {
-            if (i > 0) outFile << ",";
-            outFile << (q.correctAnswers[i] + 1);
+
+        // ׷ӵ
+        long long id = store.append(formatQuestion(q));
+        if (id < 0) {
+            cerr << "дʧܣ\n";
+            return 1;
         }
-        outFile << "\n#END\n\n";
-        
+        cout << "ѱΪ " << id + 1 << " \n";
+
         cout << "ǷĿ([y]/n)";
         getline(cin, choice);
     } while (choice[0] != 'n' && choice[0] != 'N');
 
-    outFile.close();
+    store.close();
     cout << "Ŀѱ浽 " << filename << "\n";
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,244 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+
+#include "../Common/bank-set.h"
+#include "../Common/dedup-index.h"
+#include "../Common/exam-paper.h"
+#include "../Common/question-sampler.h"
+#include "../Common/thread-pool.h"
+
+using namespace std;
+
+// Ծɣа͵⣬ N Ŀ˳ѡ˳򶼲ͬԾÿݸһļ.key
+// Ĵ⿨ obj-quiz --batch --key з֡ʱȫ֡
+// ÷obj-paper ... --variants N [--quota judge=10,choice=20,multichoice=5 | --count N] [--seed S]
+//                 [--same-questions] [--out Ŀ¼] [--name ǰ׺]
+//   --quota͵--countи͵ı䣻ָʱʹȫ͹
+//   --same-questionsԾĿֻͬ˳ѡ˳ͬĬÿݵ⣩
+//   --outĿ¼Ĭ papersÿԾд <ǰ׺>-01.txt  <ǰ׺>-01.keyǰ׺Ĭ paper
+//   ԾͷֽڣжϡѡѡĿ˳Ծڶ߳ϲ
+
+// ã͵ȡи͵ıȡ count  obj-quiz --stratify type ͬ
+struct PaperSpec {
+    bool byQuota = false;
+    array<size_t, kQuestionTypeCount> quota{};
+    size_t count = 0;
+};
+
+// ⣺ͷֽڣ˳
+vector<uint32_t> drawQuestions(const vector<Question>& questions, const TypePartitions& pools, const PaperSpec& spec,
+                               QuizRandom& rng) {
+    vector<uint32_t> picks;
+    if (!spec.byQuota) {
+        picks = sampleStratified(vector<vector<uint32_t>>(pools.begin(), pools.end()), spec.count, rng);
+        stable_sort(picks.begin(), picks.end(),
+                    [&](uint32_t a, uint32_t b) { return questions[a].type < questions[b].type; });
+        return picks;
+    }
+    for (size_t t = 0; t < kQuestionTypeCount; ++t) {
+        for (uint32_t pos : sampleIndices(pools[t].size(), spec.quota[t], rng)) picks.push_back(pools[t][pos]);
+    }
+    return picks;
+}
+
+// Ŀ--same-questions ʱԾһĿ
+void shuffleSections(vector<uint32_t>& picks, const vector<Question>& questions, QuizRandom& rng) {
+    for (size_t begin = 0; begin < picks.size();) {
+        size_t end = begin;
+        while (end < picks.size() && questions[picks[end]].type == questions[picks[begin]].type) ++end;
+        for (size_t i = end - begin; i > 1; --i) {
+            swap(picks[begin + i - 1], picks[begin + rng.below(i)]);
+        }
+        begin = end;
+    }
+}
+
+ExamPaper makePaper(const vector<uint32_t>& picks, const vector<Question>& questions,
+                    const vector<uint64_t>& fingerprints, uint64_t seed, size_t variant, QuizRandom& rng) {
+    ExamPaper paper;
+    paper.seed = seed;
+    paper.variant = variant;
+    paper.items.resize(picks.size());
+    for (size_t i = 0; i < picks.size(); ++i) {
+        const Question& q = questions[picks[i]];
+        PaperItem& item = paper.items[i];
+        item.question = picks[i];
+        item.type = q.type;
+        item.fingerprint = fingerprints[picks[i]];
+        item.order.resize(q.options.size());
+        for (size_t j = 0; j < item.order.size(); ++j) item.order[j] = static_cast<int>(j);
+        if (questionTypeInfo(q.type).shuffleOptions) shuffleInPlace(item.order, rng);
+    }
+    return paper;
+}
+
+// ԾģÿͿͷԭе䣩ѡҺ˳±
+void appendPaperText(string& out, const ExamPaper& paper, const vector<Question>& questions, size_t variants) {
+    char buf[128];
+    snprintf(buf, sizeof(buf), "Paper %zu / %zu    Seed: %llu    Questions: %zu\n", paper.variant, variants,
+             static_cast<unsigned long long>(paper.seed), paper.items.size());
+    out += buf;
+    out += "Answer sheet: one line per question in order, e.g. A or A,C; judge questions use 1/2\n";
+    for (size_t i = 0; i < paper.items.size(); ++i) {
+        const PaperItem& item = paper.items[i];
+        const Question& q = questions[item.question];
+        if (i == 0 || item.type != paper.items[i - 1].type) {
+            out += "\n";
+            out += questionTypeInfo(item.type).label;
+            out += "\n";
+        }
+        snprintf(buf, sizeof(buf), "\n%zu. ", i + 1);
+        out += buf;
+        for (size_t j = 0; j < q.question.size(); ++j) {
+            if (j) out += "   ";
+            out += q.question[j];
+            out += "\n";
+        }
+        if (q.question.empty()) out += "\n";
+        for (size_t k = 0; k < item.order.size(); ++k) {
+            out += "   ";
+            appendOptionLabel(out, item.type, k);
+            out += ". ";
+            out += q.options[item.order[k]];
+            out += "\n";
+        }
+    }
+}
+
+// ļƴúһд
+bool writeWhole(const string& path, const string& text) {
+    ofstream out(path, ios::binary | ios::trunc);
+    out.write(text.data(), text.size());
+    out.close();
+    return static_cast<bool>(out);
+}
+
+//  --quota judge=10,choice=20ִСд
+bool parseQuota(const string& text, array<size_t, kQuestionTypeCount>& quota) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t comma = text.find(',', pos);
+        string item = text.substr(pos, comma == string::npos ? string::npos : comma - pos);
+        pos = comma == string::npos ? text.size() : comma + 1;
+        size_t eq = item.find('=');
+        if (eq == string::npos) return false;
+        string name = item.substr(0, eq);
+        transform(name.begin(), name.end(), name.begin(), ::toupper);
+        QuestionType type;
+        if (!parseQuestionType(name, type) || !isObjective(type)) return false;
+        quota[static_cast<size_t>(type)] = strtoull(item.c_str() + eq + 1, nullptr, 10);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> patterns;
+    string outDir = "papers", name = "paper";
+    size_t variants = 1;
+    uint64_t seed = 0;
+    bool seeded = false, sameQuestions = false;
+    PaperSpec spec;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--variants" && i + 1 < argc) variants = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--count" && i + 1 < argc) spec.count = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+            seeded = true;
+        } else if (arg == "--out" && i + 1 < argc) outDir = argv[++i];
+        else if (arg == "--name" && i + 1 < argc) name = argv[++i];
+        else if (arg == "--same-questions") sameQuestions = true;
+        else if (arg == "--quota" && i + 1 < argc) {
+            spec.byQuota = true;
+            if (!parseQuota(argv[++i], spec.quota)) {
+                cerr << "Invalid --quota, expected e.g. judge=10,choice=20,multichoice=5\n";
+                return 1;
+            }
+        } else if (arg.compare(0, 2, "--") != 0) patterns.push_back(arg);
+        else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (patterns.empty() || variants == 0) {
+        cerr << "Usage: obj-paper bank... --variants N [--quota judge=10,choice=20,multichoice=5 | --count N]"
+                " [--seed S] [--same-questions] [--out dir] [--name prefix]\n";
+        return 1;
+    }
+    if (!seeded) seed = randomSeed();
+
+    auto start = chrono::steady_clock::now();
+    BankSet banks;
+    loadBanks(expandBankPatterns(patterns), banks);
+    vector<Question>& questions = banks.questions;
+    questions.erase(remove_if(questions.begin(), questions.end(),
+                              [](const Question& q) { return !isObjective(q.type); }),
+                    questions.end());
+    if (questions.empty()) {
+        cerr << "No objective questions found\n";
+        return 1;
+    }
+    vector<uint64_t> fingerprints(questions.size());
+    parallelFor(questions.size(), [&](size_t i) { fingerprints[i] = questionFingerprint(questions[i]); });
+    TypePartitions pools = partitionByType(questions);
+
+    if (spec.byQuota) {
+        for (size_t t = 0; t < kQuestionTypeCount; ++t) {
+            if (spec.quota[t] > pools[t].size()) {
+                cerr << "Not enough " << questionTypeName(static_cast<QuestionType>(t)) << " questions: "
+                     << spec.quota[t] << " requested, " << pools[t].size() << " available\n";
+                return 1;
+            }
+        }
+    } else if (spec.count == 0 || spec.count > questions.size()) {
+        spec.count = questions.size();
+    }
+
+    error_code ec;
+    filesystem::create_directories(outDir, ec);
+    vector<uint32_t> shared;
+    if (sameQuestions) {
+        QuizRandom rng(paperSeed(seed, 0));
+        shared = drawQuestions(questions, pools, spec, rng);
+    }
+    int width = static_cast<int>(max<size_t>(2, to_string(variants).size()));
+    vector<char> written(variants, 0);
+    parallelFor(variants, [&](size_t v) {
+        uint64_t variantSeed = paperSeed(seed, v + 1);
+        QuizRandom rng(variantSeed);
+        vector<uint32_t> picks = shared;
+        if (sameQuestions) shuffleSections(picks, questions, rng);
+        else picks = drawQuestions(questions, pools, spec, rng);
+        ExamPaper paper = makePaper(picks, questions, fingerprints, variantSeed, v + 1, rng);
+
+        string text, key;
+        text.reserve(picks.size() * 256);
+        key.reserve(picks.size() * 48);
+        appendPaperText(text, paper, questions, variants);
+        appendPaperKey(key, paper, questions);
+        char file[64];
+        snprintf(file, sizeof(file), "-%0*zu", width, v + 1);
+        string base = (filesystem::path(outDir) / (name + file)).string();
+        written[v] = writeWhole(base + ".txt", text) && writeWhole(base + ".key", key);
+    });
+
+    size_t failed = count_if(written.begin(), written.end(), [](char ok) { return !ok; });
+    size_t perPaper = spec.count;
+    if (spec.byQuota) perPaper = accumulate(spec.quota.begin(), spec.quota.end(), size_t(0));
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    printf("Generated %zu papers with %zu questions each in %s (seed %llu, %.1f ms)\n", variants - failed, perPaper,
+           outDir.c_str(), static_cast<unsigned long long>(seed), ms);
+    if (failed > 0) {
+        cerr << "Unable to write " << failed << " papers in " << outDir << "\n";
+        return 1;
+    }
+    return 0;
+}
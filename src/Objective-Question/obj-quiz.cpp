@@ -3,10 +3,28 @@
 #include <vector>
 #include <string>
 #include <algorithm>
-#include <random>
 #include <sstream>
 #include <ctime>
 #include <cctype>  // ַСдת
+#include <charconv>
+#include <iomanip>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+
+#include "../Common/answer-journal.h"
+#include "../Common/answer-mask.h"
+#include "../Common/bank-set.h"
+#include "../Common/console-encoding.h"
+#include "../Common/exam-paper.h"
+#include "../Common/item-response.h"
+#include "../Common/lazy-bank.h"
+#include "../Common/near-duplicate.h"
+#include "../Common/question-sampler.h"
+#include "../Common/review-scheduler.h"
+#include "../Common/search-index.h"
+#include "../Common/session-telemetry.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -14,22 +32,6 @@
 
 using namespace std;
 
-struct Question {
-    string type;       // ͣJUDGE/CHOICE/MULTICHOICE
-    vector<string> question;   // ⣨ı
-    vector<string> options;  // ѡ
-    vector<int> correctAnswers;  // ȷ𰸱
-};
-
-// ĸA/B/C/DתΪ
-int charToIndex(char c) {
-    c = toupper(c);  // תΪд
-    if (c >= 'A' && c <= 'Z') {
-        return c - 'A';
-    }
-    return -1;  // Чַ
-}
-
 // תΪĸA/B/C/D
 char indexToChar(int idx) {
     if (idx >= 0 && idx < 26) {
@@ -38,109 +40,75 @@ char indexToChar(int idx) {
     return '?';  // Χ
 }
 
-// ȡ
-vector<Question> loadQuestions(const string& filename) {
-    vector<Question> questions;
-    ifstream file(filename);
-    if (!file) {
-        cerr << "Unable to read file: " << filename << endl;
-        return questions;
-    }
-
-    string line;
-    Question q;
-    enum State { NONE, IN_QUESTION, IN_OPTIONS, IN_CORRECT } state = NONE;
-
-    while (getline(file, line)) {
-        if (line.substr(0, 7) == "#JUDGE" || 
-            line.substr(0, 7) == "#CHOICE" || 
-            line.substr(0, 12) == "#MULTICHOICE") {
-            if (!q.question.empty()) {
-                questions.push_back(q);
-            }
-            q = Question();
-            q.type = line.substr(1);  // ȥ#
-            state = IN_QUESTION;  // лȡ״̬
-        } else if (line == "#OPTIONS") {
-            state = IN_OPTIONS;
-        } else if (line == "#CORRECT") {
-            state = IN_CORRECT;
-        } else if (line == "#END") {
-            questions.push_back(q);
-            q = Question();
-            state = NONE;
-        } else if (!line.empty()) {
-            switch (state) {
-                case IN_QUESTION:
-                    q.question.push_back(line);  // 
-                    break;
-                case IN_OPTIONS:
-                    q.options.push_back(line);
-                    break;
-                case IN_CORRECT: {
-                    // ȷ
-                    size_t pos = 0;
-                    while (pos < line.size()) {
-                        size_t comma = line.find(',', pos);
-                        if (comma == string::npos) {
-                            q.correctAnswers.push_back(stoi(line.substr(pos)) - 1);
-                            break;
-                        }
-                        q.correctAnswers.push_back(stoi(line.substr(pos, comma - pos)) - 1);
-                        pos = comma + 1;
-                    }
-                    break;
-                }
-                default:
-                    break;
-            }
-        }
+// λͼѡݶţŷָ
+void appendMaskOptions(string& out, const Question& q, uint32_t mask) {
+    bool first = true;
+    for (; mask; mask &= mask - 1) {
+        size_t idx = lowestBit(mask);
+        if (idx >= q.options.size()) continue;
+        if (!first) out += ",";
+        out += q.options[idx];
+        first = false;
     }
+}
 
-    if (!q.question.empty()) {
-        questions.push_back(q);
-    }
-    file.close();
-    return questions;
+// һĶƼ¼Ȿ--binary-journal¼
+JournalEntry makeJournalEntry(const Question& q, uint64_t fingerprint, uint32_t userAnswers) {
+    JournalEntry entry{};
+    entry.fingerprint = fingerprint;
+    entry.time = static_cast<int64_t>(time(nullptr));
+    entry.userAnswers = userAnswers;
+    entry.correctAnswers = q.correctAnswers;
+    entry.type = static_cast<uint8_t>(q.type);
+    entry.correct = userAnswers == q.correctAnswers;
+    entry.source = q.source;
+    return entry;
 }
 
-// д𰸵ļ
-void writeAnswerToFile(const Question& q, const vector<int>& userAnswers) {
-    ofstream answerFile("obj-answers.txt", ios::app);
-    if (!answerFile) {
-        cerr << "Unable to create obj-answers.txt\n";
+// ¼obj-attempts.qjlԴ¼obj-calibrate ĿѶȡã˳ʱдʣ¼
+AnswerJournal& attemptLog() {
+    static AnswerJournal log;
+    return log;
+}
+
+// д𰸵Ȿbinary Ϊ true ʱдյĶƼ¼
+void writeAnswerToFile(AnswerJournal& journal, const Question& q, uint32_t userAnswers, bool binary) {
+    if (binary) {
+        journal.append(makeJournalEntry(q, questionFingerprint(q), userAnswers));
         return;
     }
 
-    answerFile << "#" << q.type << "\n";
+    string record;
+    record += "#";
+    record += questionTypeName(q.type);
+    record += "\n";
     // д
     for (const auto& line : q.question) {
-        answerFile << line << "\n";
+        record += line;
+        record += "\n";
     }
     
     // ʾѡ
-    answerFile << "#OPTIONS\n";
+    record += "#OPTIONS\n";
+    bool numbered = questionTypeInfo(q.type).numberedOptions;
     for (size_t j = 0; j < q.options.size(); ++j) {
-        if (q.type == "JUDGE") {
-            answerFile << j + 1 << ". " << q.options[j] << "\n";
+        if (numbered) {
+            record += to_string(j + 1);
         } else {
-            answerFile << indexToChar(j) << ". " << q.options[j] << "\n";
+            record += indexToChar(j);
         }
+        record += ". ";
+        record += q.options[j];
+        record += "\n";
     }
     
-    answerFile << "#USER_ANSWER\n";
-    for (size_t i = 0; i < userAnswers.size(); ++i) {
-        if (i > 0) answerFile << ",";
-        answerFile << q.options[userAnswers[i]];  // ѡݶ
-    }
-    answerFile << "\n#CORRECT_ANSWER\n";
-    for (size_t i = 0; i < q.correctAnswers.size(); ++i) {
-        if (i > 0) answerFile << ",";
-        answerFile << q.options[q.correctAnswers[i]];  // ѡݶ
-    }
-    answerFile << "\n#END\n\n";
+    record += "#USER_ANSWER\n";
+    appendMaskOptions(record, q, userAnswers);
+    record += "\n#CORRECT_ANSWER\n";
+    appendMaskOptions(record, q, q.correctAnswers);
+    record += "\n#END\n\n";
 
-    answerFile.close();
+    journal.append(record);
 }
 
 // ɫWindowsϵͳ
@@ -151,189 +119,758 @@ void setColor(int color) {
 #endif
 }
 
-// û𰸣ֺ֧ĸ
-vector<int> parseUserAnswer(const string& input, const vector<int>& optionIndices, const string& type) {
-    vector<int> answers;
-    size_t pos = 0;
+// һⲢз֣ʱдⱾǷ
+bool askQuestion(const Question& q, size_t number, size_t total, const vector<string>& sources,
+                 AnswerJournal& journal, bool binaryJournal, QuizRandom& rng) {
+    SessionTelemetry& tel = telemetry();
+    uint64_t fingerprint = tel.enabled() || attemptLog().isOpen() ? questionFingerprint(q) : 0;
+    uint32_t id = static_cast<uint32_t>(number);
+    uint64_t shownAt = tel.now();
+    cout << "\nQuestion " << number << " / " << total << "\n\n";
     
-    if (type == "JUDGE") {
-        // ж⴦T/F1/2
-        string trimmed = input;
-        trimmed.erase(remove_if(trimmed.begin(), trimmed.end(), ::isspace), trimmed.end());
-        if (trimmed == "T" || trimmed == "t" || trimmed == "1") {
-            answers.push_back(optionIndices[0]);
-        } else if (trimmed == "F" || trimmed == "f" || trimmed == "2") {
-            answers.push_back(optionIndices[1]);
+    // ʾݣУ
+    const QuestionTypeInfo& info = questionTypeInfo(q.type);
+    cout << info.label;
+    if (sources.size() > 1) cout << " (" << sources[q.source] << ")";
+    cout << "\n";
+
+    int code_line = 0;
+    for (size_t j = 0; j < q.question.size(); ++j) {
+        // ⵽ǰ4ոɾ4ո񣬲϶Ϊ
+        if (q.question[j].size() >= 4 && q.question[j].substr(0,4) == "    ") {
+            printf("%2d -| ", ++code_line);
+            cout << q.question[j].substr(4) << "\n";
+        } else {
+            cout << q.question[j] << "\n";
         }
-        return answers;
     }
 
-    while (pos < input.size()) {
-        // ո
-        while (pos < input.size() && isspace(input[pos])) {
-            pos++;
-        }
-        if (pos >= input.size()) break;
-
-        size_t comma = input.find(',', pos);
-        string token;
-        if (comma == string::npos) {
-            token = input.substr(pos);
-            pos = input.size();
+    cout << "\nOptions:\n";
+    
+    // ѡ
+    vector<int> optionIndices(q.options.size());
+    for (size_t j = 0; j < optionIndices.size(); ++j) {
+        optionIndices[j] = j;
+    }
+    // ѡ/ѡѡ
+    if (info.shuffleOptions) {
+        shuffleInPlace(optionIndices, rng);
+    }
+    
+    // ʾҺѡжʾT/FʾABCD
+    for (size_t j = 0; j < optionIndices.size(); ++j) {
+        if (info.numberedOptions) {
+            cout << j + 1 << ". " << q.options[optionIndices[j]] << "\n";
         } else {
-            token = input.substr(pos, comma - pos);
-            pos = comma + 1;
+            cout << indexToChar(j) << ". " << q.options[optionIndices[j]] << "\n";
+        }
+    }
+    
+    // ȡû
+    cout << "\nPlease enter the answer" << (info.multipleAnswers ? " (separate multiple answers with [,])" : "") << ": ";
+    string ansInput;
+    uint64_t promptAt = tel.now();
+    tel.record(TelemetryPhase::RENDER, shownAt, promptAt, id, fingerprint);
+    getline(cin, ansInput);
+    uint64_t answeredAt = tel.now();
+    
+    // û𰸣ֺ֧ĸõλͼ
+    uint32_t userAnswers = parseUserAnswer(ansInput, optionIndices, q.type);
+    
+    // жûǷȷλͼȼȫһ
+    bool isCorrect = (userAnswers == q.correctAnswers);
+    tel.record(TelemetryPhase::GRADE, answeredAt, tel.now(), id, fingerprint);
+    tel.record(TelemetryPhase::ANSWER, promptAt, answeredAt, id, fingerprint, isCorrect);
+    if (attemptLog().isOpen()) attemptLog().append(makeJournalEntry(q, fingerprint, userAnswers));
+
+    // ʾȷ
+    if (isCorrect) {
+        setColor(10);  // ɫ
+        cout << "\nCorrect!\n";
+        setColor(7);   // ָĬɫ
+    } else {
+        setColor(12);  // ɫ
+        cout << "\nIncorrect!";
+        cout << "Correct Answer: ";
+        bool first = true;
+        for (uint32_t m = q.correctAnswers; m; m &= m - 1) {
+            int correct = lowestBit(m);
+            if (correct >= static_cast<int>(q.options.size())) continue;
+            if (!first) cout << ",";
+            first = false;
+            // ҵȷڴҺλ
+            auto it = find(optionIndices.begin(), optionIndices.end(), correct);
+            int displayIdx = it - optionIndices.begin();
+            if (info.numberedOptions) {
+                cout << (displayIdx + 1) << "(" << q.options[correct] << ")";
+            } else {
+                cout << indexToChar(displayIdx) << "(" << q.options[correct] << ")";
+            }
         }
+        cout << "\n";
+        setColor(7);   // ָĬɫ
 
-        // ȥtokenеĿո
-        token.erase(remove_if(token.begin(), token.end(), ::isspace), token.end());
-        if (token.empty()) continue;
+        // ֻ¼𰸵ļ
+        uint64_t writeAt = tel.now();
+        writeAnswerToFile(journal, q, userAnswers, binaryJournal);
+        tel.record(TelemetryPhase::JOURNAL, writeAt, tel.now(), id, fingerprint);
+    }
+    cout << endl;
+    return isCorrect;
+}
 
-        int idx = -1;
-        if (isdigit(token[0])) {
-            // 루1/2/3/4
-            idx = stoi(token) - 1;
-        } else {
-            // ĸ루A/B/C/D
-            idx = charToIndex(token[0]);
+// λỰÿʱλ 90 λ
+void printAnswerTimes() {
+    const LatencyHistogram& h = telemetry().histogram(TelemetryPhase::ANSWER);
+    if (h.count() == 0) return;
+    cout << fixed << setprecision(1) << "Time per question: median " << h.percentile(0.5) / 1e9 << " s, p90 "
+         << h.percentile(0.9) / 1e9 << " s, total " << h.sum() / 1e9 << " s\n";
+    cout.unsetf(ios::fixed);
+}
+
+// ãcount Ϊ0 ʾȫstratify Ϊֲ㷽ʽtype  / bank Դ⣬ձʾֲ㣩
+// ѡ˳ͳ⹲ rngָ --seed ʱ
+struct SamplingOptions {
+    size_t count = 0;
+    string stratify;
+    uint64_t seed = 0;
+    QuizRandom rng;
+};
+
+// ѭȡ 0..total-1 ⣬questionAt  nullptr Ŀ limit 
+// sources ΪļʱͺʾĿԴbinaryJournal Ϊ true ʱ¼дƵ obj-answers.qjl
+void runQuiz(size_t total, size_t limit, const function<const Question*(size_t)>& questionAt,
+             const vector<string>& sources, bool binaryJournal, QuizRandom& rng) {
+    // ỰֻһδⱾ
+    string journalPath = binaryJournal ? "obj-answers.qjl" : "obj-answers.txt";
+    AnswerJournal journal;
+    if (!journal.open(journalPath)) {
+        cerr << "Unable to create " << journalPath << "\n";
+    }
+
+    int correctCount = 0;
+    size_t totalQuestions = 0;
+    size_t shown = min(total, limit);
+
+    for (size_t i = 0; i < total && totalQuestions < limit; ++i) {
+        const Question* q = questionAt(i);
+        if (q == nullptr) continue;
+        if (askQuestion(*q, ++totalQuestions, shown, sources, journal, binaryJournal, rng)) {
+            correctCount++;
         }
+    }
+
+    cout << "\nQuiz over, correct " << correctCount << " questions out of " << totalQuestions << ".";
+    cout << " Accuracy: " << (correctCount * 100.0 / max(totalQuestions, size_t(1))) << "%\n";
+    printAnswerTimes();
+
+    journal.close();
+    cout << "\nIncorrect answers have been recorded in " << journalPath << "\n";
+    cout << "Press [ENTER] to exit...";
+    getchar();
+}
 
-        // ǷЧ
-        if (idx >= 0 && idx < (int)optionIndices.size()) {
-            answers.push_back(optionIndices[idx]);
+// ͻԴŷֲ
+vector<vector<uint32_t>> buildStrata(const vector<Question>& questions, const string& by) {
+    vector<vector<uint32_t>> strata;
+    for (size_t i = 0; i < questions.size(); ++i) {
+        size_t s = by == "bank" ? questions[i].source : static_cast<size_t>(questions[i].type);
+        if (s >= strata.size()) strata.resize(s + 1);
+        strata[s].push_back(static_cast<uint32_t>(i));
+    }
+    return strata;
+}
+
+// ѡģʽ˳⣬ȡ count ⣨ֻţƶĿ
+void quizMode(const vector<Question>& questions, bool randomOrder, const vector<string>& sources,
+              bool binaryJournal, SamplingOptions& sampling) {
+    size_t count = sampling.count ? min(sampling.count, questions.size()) : questions.size();
+    vector<uint32_t> order;
+    if (!randomOrder) {
+        order.resize(count);
+        for (size_t i = 0; i < count; ++i) order[i] = static_cast<uint32_t>(i);
+    } else {
+        cout << "Random seed: " << sampling.seed << "\n";
+        if (sampling.stratify.empty()) {
+            order = sampleIndices(questions.size(), count, sampling.rng);
+        } else {
+            order = sampleStratified(buildStrata(questions, sampling.stratify), count, sampling.rng);
         }
     }
+    runQuiz(order.size(), order.size(), [&](size_t i) { return &questions[order[i]]; }, sources, binaryJournal,
+            sampling.rng);
+}
 
-    return answers;
+// صѡģʽ--lazy˳ţĳʱŽ
+void lazyQuizMode(LazyBank& bank, bool randomOrder, const vector<string>& sources, bool binaryJournal,
+                  SamplingOptions& sampling) {
+    // еᱻʾֻ͹
+    size_t objective = bank.objectiveCount();
+    size_t limit = sampling.count ? min(sampling.count, objective) : objective;
+    IndexPermutation permutation(bank.size(), sampling.rng);
+    if (randomOrder) cout << "Random seed: " << sampling.seed << "\n";
+    // runQuiz  0, 1, 2... ˳ȡ⣬ʱȡеһ
+    runQuiz(bank.size(), limit, [&](size_t i) {
+        uint64_t start = telemetry().now();
+        const Question* q = bank.get(randomOrder ? permutation.next() : i);
+        telemetry().record(TelemetryPhase::PARSE, start, telemetry().now());
+        return q && isObjective(q->type) ? q : nullptr;
+    }, sources, binaryJournal, sampling.rng);
 }
 
-// ѡģʽ
-void quizMode(vector<Question>& questions, bool randomOrder) {
-    if (randomOrder) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        default_random_engine rng(rand());
-        shuffle(questions.begin(), questions.end(), rng);
+// ϰģʽظSM-2ȳѵڵ⣬ٳ 20 δϰ⣬ʮӺڱθϰٴγ
+// ϰȱ obj-review.qrs״ʹʱеĴⱾʷ
+void reviewMode(const vector<Question>& questions, const vector<string>& sources, bool binaryJournal,
+                QuizRandom& rng) {
+    const string storePath = "obj-review.qrs";
+    ReviewStore store;
+    int64_t now = static_cast<int64_t>(time(nullptr));
+    if (!store.load(storePath)) {
+        size_t imported = importTextHistory("obj-answers.txt", store, now) +
+                          importJournalHistory("obj-answers.qjl", store);
+        if (imported > 0) cout << "Imported " << imported << " records from previous answer logs.\n";
+    }
+
+    vector<uint64_t> fingerprints(questions.size());
+    parallelFor(questions.size(), [&](size_t i) { fingerprints[i] = questionFingerprint(questions[i]); });
+    DueQueue queue(store, fingerprints);
+    size_t due = queue.dueCount(now), fresh = queue.newCount();
+    if (due + fresh == 0) {
+        cout << "\nNo questions are due for review.\n";
+        return;
+    }
+    cout << "\n" << due << " questions due for review";
+    if (fresh > 0) cout << ", then " << fresh << " new questions";
+    cout << ".\n";
+
+    string journalPath = binaryJournal ? "obj-answers.qjl" : "obj-answers.txt";
+    AnswerJournal journal;
+    if (!journal.open(journalPath)) {
+        cerr << "Unable to create " << journalPath << "\n";
     }
 
     int correctCount = 0;
-    int totalQuestions = questions.size();
+    int asked = 0;
+    for (long long idx; (idx = queue.popDue(now)) >= 0; now = static_cast<int64_t>(time(nullptr))) {
+        ++asked;
+        // ŵ
+        size_t total = max(due + fresh, static_cast<size_t>(asked));
+        bool isCorrect = askQuestion(questions[idx], asked, total, sources, journal, binaryJournal, rng);
+        if (isCorrect) correctCount++;
+        const ReviewState& s = store.review(fingerprints[idx], isCorrect ? 4 : 1, now);
+        queue.push(idx, s.due);
+        if (isCorrect) cout << "Next review in " << s.interval << " day(s).\n";
+    }
 
+    cout << "\nReview over, correct " << correctCount << " answers out of " << asked << ".\n";
+    printAnswerTimes();
+    journal.close();
+    if (!store.save(storePath)) {
+        cerr << "Unable to save " << storePath << "\n";
+    } else {
+        cout << "Review progress has been saved in " << storePath << "\n";
+    }
+    cout << "Press [ENTER] to exit...";
+    getchar();
+}
+
+// Ӧ⣨--adaptiveֻ obj-calibrate У׼⣬ÿγڵǰϢ⣬
+// һƣ--countĬ 20Ƶı׼С 0.3 ʱ
+const size_t kAdaptiveQuestions = 20;
+const double kAdaptiveTargetSe = 0.3;
+
+void adaptiveMode(const vector<Question>& questions, const string& calibrationFile, const vector<string>& sources,
+                  bool binaryJournal, SamplingOptions& sampling) {
+    unordered_map<uint64_t, ItemCalibration> calibration;
+    if (!loadCalibration(calibrationFile, calibration)) {
+        cerr << "Unable to read " << calibrationFile << endl;
+        return;
+    }
+    vector<uint64_t> fingerprints(questions.size());
+    parallelFor(questions.size(), [&](size_t i) { fingerprints[i] = questionFingerprint(questions[i]); });
+    vector<pair<uint32_t, ItemParameters>> candidates;
     for (size_t i = 0; i < questions.size(); ++i) {
-        const auto& q = questions[i];
-        cout << "\nQuestion " << i + 1 << " / " << questions.size() << "\n\n";
-        
-        // ʾݣУ
-        string typeStr;
-        if (q.type == "JUDGE") typeStr = "[Judge/ж]";
-        else if (q.type == "CHOICE") typeStr = "[Choice/ѡ]";
-        else if (q.type == "MULTICHOICE") typeStr = "[Multi-choice/ѡ]";
-        cout << typeStr << "\n";
-
-        int code_line = 0;
-        for (size_t j = 0; j < q.question.size(); ++j) {
-            // ⵽ǰ4ոɾ4ո񣬲϶Ϊ
-            if (q.question[j].size() >= 4 && q.question[j].substr(0,4) == "    ") {
-                printf("%2d -| ", ++code_line);
-                cout << q.question[j].substr(4) << "\n";
-            } else {
-                cout << q.question[j] << "\n";
+        auto it = calibration.find(fingerprints[i]);
+        if (it != calibration.end()) candidates.push_back({static_cast<uint32_t>(i), it->second.params});
+    }
+    if (candidates.empty()) {
+        cout << "\nNo calibrated questions in " << calibrationFile << ", please run obj-calibrate first.\n";
+        return;
+    }
+    // Һ˳ȽϣϢͬѡһ
+    shuffleInPlace(candidates, sampling.rng);
+    size_t limit = min(sampling.count ? sampling.count : kAdaptiveQuestions, candidates.size());
+    cout << "\nAdaptive quiz: " << candidates.size() << " calibrated questions, up to " << limit
+         << " will be asked.\n";
+
+    string journalPath = binaryJournal ? "obj-answers.qjl" : "obj-answers.txt";
+    AnswerJournal journal;
+    if (!journal.open(journalPath)) {
+        cerr << "Unable to create " << journalPath << "\n";
+    }
+
+    AbilityTracker tracker;
+    int correctCount = 0;
+    size_t asked = 0;
+    while (asked < limit && tracker.se() >= kAdaptiveTargetSe) {
+        size_t best = asked;
+        double bestInfo = -1;
+        for (size_t k = asked; k < candidates.size(); ++k) {
+            double info = tracker.expectedInformation(candidates[k].second);
+            if (info > bestInfo) {
+                bestInfo = info;
+                best = k;
             }
         }
+        swap(candidates[asked], candidates[best]);  // ѳƵǰ
+        const auto& [idx, params] = candidates[asked];
+        bool isCorrect = askQuestion(questions[idx], ++asked, limit, sources, journal, binaryJournal, sampling.rng);
+        if (isCorrect) correctCount++;
+        tracker.update(params, isCorrect);
+        cout << fixed << setprecision(2) << "Ability estimate: " << tracker.mean() << " +/- " << tracker.se()
+             << "\n";
+        cout.unsetf(ios::fixed);
+    }
 
-        cout << "\nOptions:\n";
-        
-        // ѡ
-        vector<int> optionIndices(q.options.size());
-        for (size_t j = 0; j < optionIndices.size(); ++j) {
-            optionIndices[j] = j;
+    cout << "\nAdaptive quiz over, correct " << correctCount << " answers out of " << asked << ".\n";
+    cout << fixed << setprecision(2) << "Estimated ability: " << tracker.mean() << " (standard error "
+         << tracker.se() << ", population mean 0, standard deviation 1)\n";
+    cout.unsetf(ios::fixed);
+    printAnswerTimes();
+    journal.close();
+    cout << "\nIncorrect answers have been recorded in " << journalPath << "\n";
+    cout << "Press [ENTER] to exit...";
+    getchar();
+}
+
+// һݴ⿨зֽ
+struct SheetResult {
+    bool loaded = false;
+    int correct = 0;
+    vector<char> correctFlags;  // ÿУÿ⣩Ƿ
+    vector<char> answered;      // ÿǷ
+};
+
+// ⿨ k жӦĿѡ˳
+struct SheetItem {
+    uint32_t question;
+    QuestionType type;
+    const vector<int>* order;
+};
+
+// ⿨Ŀţ --key ʱΪеÿ⣨ѡң --key ʱΪ÷ԾĿ
+struct SheetLayout {
+    vector<SheetItem> items;
+    TypePartitions parts;  // ͷк
+};
+
+// з֣ȡһݴ⿨ layout з
+// .csv ⿨ÿΪ "," 3,A,CļÿζӦһ⡣
+// ȰÿĴȡٰͷз֣ÿѭֻһ͵Ľ
+SheetResult gradeSheet(const string& filename, const vector<Question>& questions, const SheetLayout& layout) {
+    SheetResult result;
+    MappedFile file;
+    if (!file.open(filename)) {
+        cerr << "Unable to read answer sheet: " << filename << endl;
+        return result;
+    }
+    size_t total = layout.items.size();
+    result.loaded = true;
+    result.correctFlags.assign(total, 0);
+    result.answered.assign(total, 0);
+    bool csv = filename.size() >= 4 && filename.substr(filename.size() - 4) == ".csv";
+
+    vector<string_view> answers(total);
+    string_view text = file.view();
+    size_t lineNo = 0;
+    while (!text.empty()) {
+        size_t nl = text.find('\n');
+        string_view line = text.substr(0, nl);
+        text = (nl == string_view::npos) ? string_view() : text.substr(nl + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        size_t idx = lineNo++;
+        if (csv) {
+            size_t comma = line.find(',');
+            int number = 0;
+            auto res = from_chars(line.data(), line.data() + (comma == string_view::npos ? line.size() : comma), number);
+            if (res.ec != errc() || number < 1 || comma == string_view::npos) continue;  // ͷЧ
+            idx = number - 1;
+            line = line.substr(comma + 1);
         }
-        // ѡ/ѡѡ
-        if (q.type == "CHOICE" || q.type == "MULTICHOICE") {
-            default_random_engine rng(static_cast<unsigned int>(time(nullptr)) + i);
-            shuffle(optionIndices.begin(), optionIndices.end(), rng);
+        if (idx >= total) continue;
+        answers[idx] = line;
+    }
+
+    forEachPartition(layout.parts, [&](auto tag, const vector<uint32_t>& rows) {
+        for (uint32_t k : rows) {
+            const SheetItem& item = layout.items[k];
+            uint32_t answer = parseUserAnswerAs<decltype(tag)::value>(answers[k], *item.order);
+            result.answered[k] = answer != 0;
+            result.correctFlags[k] = answer == questions[item.question].correctAnswers;
         }
-        
-        // ʾҺѡжʾT/FʾABCD
-        for (size_t j = 0; j < optionIndices.size(); ++j) {
-            if (q.type == "JUDGE") {
-                cout << j + 1 << ". " << q.options[optionIndices[j]] << "\n";
-            } else {
-                cout << indexToChar(j) << ". " << q.options[optionIndices[j]] << "\n";
-            }
+    });
+    for (char c : result.correctFlags) result.correct += c;
+    return result;
+}
+
+//  .key һԾϵĿҲĳʱѸĶͬһ⣩ false
+bool resolvePaper(const string& keyFile, ExamPaper& paper, const unordered_map<uint64_t, uint32_t>& byFingerprint,
+                  SheetLayout& layout) {
+    string error;
+    if (!loadPaperKey(keyFile, paper, error)) {
+        cerr << "Unable to load answer key " << keyFile << ": " << error << endl;
+        return false;
+    }
+    for (size_t k = 0; k < paper.items.size(); ++k) {
+        PaperItem& item = paper.items[k];
+        auto it = byFingerprint.find(item.fingerprint);
+        if (it == byFingerprint.end()) {
+            cerr << "Answer key " << keyFile << ": question " << k + 1 << " is not in the bank" << endl;
+            return false;
         }
-        
-        // ȡû
-        vector<int> userAnswers;
-        cout << "\nPlease enter the answer" << (q.type == "MULTICHOICE" ? " (separate multiple answers with [,])" : "") << ": ";
-        string ansInput;
-        getline(cin, ansInput);
-        
-        // û𰸣ֺ֧ĸ
-        userAnswers = parseUserAnswer(ansInput, optionIndices, q.type);
-        
-        // жûǷȷбȽ
-        vector<int> userAnswersSorted = userAnswers;
-        vector<int> correctAnswersSorted = q.correctAnswers;
-        sort(userAnswersSorted.begin(), userAnswersSorted.end());
-        sort(correctAnswersSorted.begin(), correctAnswersSorted.end());
-        bool isCorrect = (userAnswersSorted == correctAnswersSorted && userAnswers.size() == q.correctAnswers.size());
-
-        // ʾȷ
-        if (isCorrect) {
-            setColor(10);  // ɫ
-            cout << "\nCorrect!\n";
-            setColor(7);   // ָĬɫ
-            correctCount++;
-        } else {
-            setColor(12);  // ɫ
-            cout << "\nIncorrect!";
-            cout << "Correct Answer: ";
-            for (size_t j = 0; j < q.correctAnswers.size(); ++j) {
-                if (j > 0) cout << ",";
-                // ҵȷڴҺλ
-                auto it = find(optionIndices.begin(), optionIndices.end(), q.correctAnswers[j]);
-                int displayIdx = it - optionIndices.begin();
-                if (q.type == "JUDGE") {
-                    cout << (displayIdx + 1) << "(" << q.options[q.correctAnswers[j]] << ")";
-                } else {
-                    cout << indexToChar(displayIdx) << "(" << q.options[q.correctAnswers[j]] << ")";
-                }
-            }
-            cout << "\n";
-            setColor(7);   // ָĬɫ
+        item.question = it->second;
+        layout.items.push_back({item.question, item.type, &item.order});
+    }
+    layout.parts = partitionByType(layout.items);
+    return true;
+}
+
+// ģʽֻһΣ⿨ڶ߳ϲз֣ܱ
+// sheetKeys[i] Ϊ i ݴ⿨ʹõ keyFiles ±꣬-1 ʾ˳
+int batchMode(const vector<Question>& questions, const vector<string>& sheets, const vector<int>& sheetKeys,
+              const vector<string>& keyFiles, const string& reportFile) {
+    // ѡʱѡ˳򣬰ѡԤɣзʱٷ
+    vector<vector<int>> identity(33);
+    for (size_t n = 0; n < identity.size(); ++n) {
+        for (size_t j = 0; j < n; ++j) identity[n].push_back(j);
+    }
 
-            // ֻ¼𰸵ļ
-            writeAnswerToFile(q, userAnswers);
+    // layouts[0] Ϊ⣬layouts[j + 1] Ϊ keyFiles[j] Ծ
+    vector<SheetLayout> layouts(keyFiles.size() + 1);
+    if (count(sheetKeys.begin(), sheetKeys.end(), -1) > 0) {
+        for (size_t i = 0; i < questions.size(); ++i) {
+            const Question& q = questions[i];
+            layouts[0].items.push_back({static_cast<uint32_t>(i), q.type, &identity[min<size_t>(q.options.size(), 32)]});
+        }
+        layouts[0].parts = partitionByType(questions);
+    }
+    vector<ExamPaper> papers(keyFiles.size());
+    if (!keyFiles.empty()) {
+        vector<uint64_t> fingerprints(questions.size());
+        parallelFor(questions.size(), [&](size_t i) { fingerprints[i] = questionFingerprint(questions[i]); });
+        unordered_map<uint64_t, uint32_t> byFingerprint;
+        for (size_t i = 0; i < questions.size(); ++i) byFingerprint.emplace(fingerprints[i], static_cast<uint32_t>(i));
+        for (size_t j = 0; j < keyFiles.size(); ++j) {
+            if (!resolvePaper(keyFiles[j], papers[j], byFingerprint, layouts[j + 1])) return 1;
         }
-        cout << endl;
     }
 
-    cout << "\nQuiz over, correct " << correctCount << " questions out of " << totalQuestions << ".";
-    cout << " Accuracy: " << (correctCount * 100.0 / totalQuestions) << "%\n";
+    vector<SheetResult> results(sheets.size());
+    parallelFor(sheets.size(), [&](size_t i) { results[i] = gradeSheet(sheets[i], questions, layouts[sheetKeys[i] + 1]); });
+
+    // ڴƴãһд
+    ostringstream report;
+    report << fixed << setprecision(2);
+    report << "sheet,correct,total,accuracy\n";
+    // ÿͳưеĿܣͬԾϵͬһһ
+    vector<int> questionCorrect(questions.size(), 0), questionAnswered(questions.size(), 0);
+    vector<int> questionServed(questions.size(), 0);
+    size_t graded = 0;
+    double accuracySum = 0;
+    for (size_t i = 0; i < sheets.size(); ++i) {
+        const SheetResult& r = results[i];
+        if (!r.loaded) continue;
+        ++graded;
+        const SheetLayout& layout = layouts[sheetKeys[i] + 1];
+        double accuracy = layout.items.empty() ? 0.0 : r.correct * 100.0 / layout.items.size();
+        accuracySum += accuracy;
+        report << sheets[i] << "," << r.correct << "," << layout.items.size() << "," << accuracy << "\n";
+        for (size_t k = 0; k < layout.items.size(); ++k) {
+            uint32_t j = layout.items[k].question;
+            questionCorrect[j] += r.correctFlags[k];
+            questionAnswered[j] += r.answered[k];
+            questionServed[j]++;
+        }
+    }
 
-    cout << "\nIncorrect answers have been recorded in obj-answers.txt\n";
-    cout << "Press [ENTER] to exit...";
-    getchar();
+    //  --key ʱֻгԾϵ⣬ȷʰֵĴ
+    report << "\nquestion,correct,answered,accuracy\n";
+    size_t listed = 0;
+    for (size_t j = 0; j < questions.size(); ++j) {
+        if (!keyFiles.empty() && questionServed[j] == 0) continue;
+        ++listed;
+        report << j + 1 << "," << questionCorrect[j] << "," << questionAnswered[j] << ","
+               << (questionServed[j] ? questionCorrect[j] * 100.0 / questionServed[j] : 0.0) << "\n";
+    }
+    report << "\nsheets," << graded << "\nquestions," << listed
+           << "\nmean_accuracy," << (graded ? accuracySum / graded : 0.0) << "\n";
+
+    string text = report.str();
+    if (reportFile.empty()) {
+        cout << text;
+    } else {
+        ofstream out(reportFile, ios::binary | ios::trunc);
+        if (!out) {
+            cerr << "Unable to write report: " << reportFile << endl;
+            return 1;
+        }
+        out.write(text.data(), text.size());
+        cout << "Graded " << graded << " answer sheets, report saved to " << reportFile << "\n";
+    }
+    return graded == sheets.size() ? 0 : 1;
+}
+
+// ȫļڸĵвѯ questions ΪƥĿ
+// ϲĿеԭ⹲ͬһͼͼĵַӦԭ
+void searchQuestions(const BankSet& banks, vector<Question>& questions, const string& query) {
+    auto start = chrono::steady_clock::now();
+    vector<SearchIndex> indexes;
+    loadSearchIndexes(banks.files, banks.banks, indexes);
+    auto loaded = chrono::steady_clock::now();
+
+    unordered_set<const string_view*> matched;
+    vector<size_t> perBank(banks.banks.size());
+    for (size_t b = 0; b < banks.banks.size(); ++b) {
+        for (uint32_t idx : indexes[b].search(query)) {
+            matched.insert(banks.banks[b].questions[idx].question.begin());
+            perBank[b]++;
+        }
+    }
+    auto done = chrono::steady_clock::now();
+
+    questions.erase(remove_if(questions.begin(), questions.end(),
+                              [&](const Question& q) { return !matched.count(q.question.begin()); }),
+                    questions.end());
+
+    cout << "Search \"" << query << "\": " << questions.size() << " matching questions";
+    cout << fixed << setprecision(2) << " (index " << chrono::duration<double, milli>(loaded - start).count()
+         << " ms, query " << chrono::duration<double, milli>(done - loaded).count() << " ms)\n";
+    cout.unsetf(ios::fixed);
+    for (size_t b = 0; b < banks.files.size(); ++b) {
+        if (perBank[b] > 0) cout << "  " << banks.files[b] << ": " << perBank[b] << "\n";
+    }
+}
+
+// 飨obj-cluster ɣͬһÿֻһһϰвͬһ汾
+void keepOnePerCluster(vector<Question>& questions, const string& clusterFile, QuizRandom& rng) {
+    vector<vector<uint64_t>> clusters;
+    if (!loadClusters(clusterFile, clusters)) {
+        cerr << "Unable to read " << clusterFile << endl;
+        return;
+    }
+    unordered_map<uint64_t, uint32_t> clusterOf;
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        for (uint64_t fp : clusters[c]) clusterOf.emplace(fp, static_cast<uint32_t>(c));
+    }
+    vector<uint64_t> fingerprints(questions.size());
+    parallelFor(questions.size(), [&](size_t i) { fingerprints[i] = questionFingerprint(questions[i]); });
+
+    // ÿڱμصĿеĳԱѡһ
+    vector<vector<uint32_t>> members(clusters.size());
+    for (size_t i = 0; i < questions.size(); ++i) {
+        auto it = clusterOf.find(fingerprints[i]);
+        if (it != clusterOf.end()) members[it->second].push_back(static_cast<uint32_t>(i));
+    }
+    vector<char> drop(questions.size(), 0);
+    for (const auto& m : members) {
+        if (m.size() < 2) continue;
+        uint32_t keep = m[rng.below(m.size())];
+        for (uint32_t idx : m) drop[idx] = idx != keep;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < questions.size(); ++i) {
+        if (!drop[i]) questions[kept++] = questions[i];
+    }
+    if (kept < questions.size()) {
+        cout << "Similar questions: kept one per group, " << questions.size() - kept << " variants skipped\n";
+        questions.erase(questions.begin() + kept, questions.end());
+    }
+}
+
+// ϲʱֵظĿ == ⣬ɵһ
+void printDuplicateReport(const BankSet& banks) {
+    for (const auto& dup : banks.duplicates) {
+        const Question& kept = banks.questions[dup.keptIndex];
+        cout << banks.files[dup.question.source] << " #" << dup.number << " == "
+             << banks.files[kept.source] << " #" << dup.keptNumber << "\n";
+        if (!dup.question.question.empty()) {
+            cout << "    " << dup.question.question[0] << "\n";
+        }
+    }
+    size_t total = banks.questions.size() + banks.duplicates.size();
+    cout << "\n" << banks.duplicates.size() << " duplicates in " << total << " questions, "
+         << banks.questions.size() << " unique\n";
 }
 
-int main() {
-    string filename;
-    cout << "Please enter the question bank filename: ";
-    getline(cin, filename);
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
+    // пԴͨ obj-quiz java1.txt java2.txt  obj-quiz "java*.txt"
+    // --dedupֻظĿ棬
+    // --batch ⿨...з֣--report ļдļĻ
+    // --key Ծ.key֮Ĵ⿨ obj-paper ɵԾĴ⿨ԾϵĿѡ˳з
+    // --binary-journal¼ʹöƸʽ
+    // --search ؼʣֻϰؼʵĿ
+    // --lazyأֻ¼ĿλãŽ⣨⣬ֻ֧˳/⣩
+    // --count ֻ N ⣬ģʽ´гȡ--stratify type|bankʱͻԴֲ
+    // --seed ӣ̶ӣѡ˳
+    // --clusters ļobj-cluster ɵ飬ÿֻһ
+    // --adaptive У׼ļobj-calibrate ɵѶУ׼Ӧ⣨--count ΪĬ 20
+    // --no-telemetry¼λỰļʱ־obj-telemetry.qtl
+    // --no-attempts¼λỰ¼obj-attempts.qjlÿһobj-calibrate 룩
+    vector<string> patterns, sheets, keyFiles;
+    vector<int> sheetKeys;
+    string reportFile, query, clusterFile, calibrationFile;
+    bool dedupReport = false, batch = false, binaryJournal = false, lazy = false, seeded = false, tracing = true;
+    bool recordAttempts = true;
+    SamplingOptions sampling;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--dedup") {
+            dedupReport = true;
+        } else if (arg == "--count" && i + 1 < argc) {
+            sampling.count = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--stratify" && i + 1 < argc) {
+            sampling.stratify = argv[++i];
+            if (sampling.stratify != "type" && sampling.stratify != "bank") {
+                cerr << "--stratify must be type or bank\n";
+                return 1;
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            sampling.seed = strtoull(argv[++i], nullptr, 10);
+            seeded = true;
+        } else if (arg == "--lazy") {
+            lazy = true;
+        } else if (arg == "--no-telemetry") {
+            tracing = false;
+        } else if (arg == "--no-attempts") {
+            recordAttempts = false;
+        } else if (arg == "--binary-journal") {
+            binaryJournal = true;
+        } else if (arg == "--batch") {
+            batch = true;
+        } else if (arg == "--search" && i + 1 < argc) {
+            query = argv[++i];
+            if (utf8Terminal()) utf8ToGbk(argv[i], query);  // вն˱ͬ
+        } else if (arg == "--report" && i + 1 < argc) {
+            reportFile = argv[++i];
+        } else if (arg == "--clusters" && i + 1 < argc) {
+            clusterFile = argv[++i];
+        } else if (arg == "--adaptive" && i + 1 < argc) {
+            calibrationFile = argv[++i];
+        } else if (arg == "--key" && i + 1 < argc) {
+            keyFiles.push_back(argv[++i]);
+        } else if (batch) {
+            sheets.push_back(arg);
+            sheetKeys.push_back(static_cast<int>(keyFiles.size()) - 1);
+        } else {
+            patterns.push_back(arg);
+        }
+    }
+    if (patterns.empty()) {
+        string filename;
+        cout << "Please enter the question bank filename: ";
+        getline(cin, filename);
+        // вļʱոɶ
+        if (filename.find_first_of("*? ") == string::npos || ifstream(filename)) {
+            patterns.push_back(filename);
+        } else {
+            istringstream iss(filename);
+            string name;
+            while (iss >> name) patterns.push_back(name);
+        }
+    }
     //  filename .txtβ
-    if (filename.size() < 4 || filename.substr(filename.size() - 4) != ".txt") {
-        filename += ".txt";
+    for (auto& filename : patterns) {
+        if (filename.size() < 4 || filename.substr(filename.size() - 4) != ".txt") {
+            filename += ".txt";
+        }
+    }
+
+    if (!seeded) sampling.seed = randomSeed();
+    sampling.rng.reseed(sampling.seed);
+    // ֻͳƴỰ--dedup зֲ¼
+    if (tracing && !dedupReport && !batch) telemetry().open("obj-telemetry.qtl", 0);
+    if (recordAttempts && !dedupReport && !batch && !attemptLog().open("obj-attempts.qjl")) {
+        cerr << "Unable to create obj-attempts.qjl\n";
     }
-    vector<Question> questions = loadQuestions(filename);
+
+    if (lazy) {
+        vector<string> files = expandBankPatterns(patterns);
+        if (files.size() != 1 || dedupReport || batch || !query.empty() || !sampling.stratify.empty() ||
+            !calibrationFile.empty()) {
+            cerr << "--lazy works with a single bank and sequential/random quiz only\n";
+            return 1;
+        }
+        auto start = chrono::steady_clock::now();
+        uint64_t loadStart = telemetry().now();
+        LazyBank bank;
+        if (!bank.open(files[0])) return 1;
+        telemetry().record(TelemetryPhase::LOAD, loadStart, telemetry().now());
+        cout << "Indexed " << bank.size() << " questions in " << fixed << setprecision(2)
+             << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms\n";
+        cout.unsetf(ios::fixed);
+        string mode;
+        cout << "Please select mode:\n1. Sequential Quiz\n2. Random Quiz\nPlease choose: ";
+        getline(cin, mode);
+        lazyQuizMode(bank, mode[0] == '2', files, binaryJournal, sampling);
+        return 0;
+    }
+
+    BankSet banks;
+    uint64_t loadStart = telemetry().now();
+    loadBanks(expandBankPatterns(patterns), banks);
+    telemetry().record(TelemetryPhase::LOAD, loadStart, telemetry().now());
+    if (dedupReport) {
+        printDuplicateReport(banks);
+        return 0;
+    }
+    vector<Question>& questions = banks.questions;
+    // ͬһļе⽻ sub-quiz
+    questions.erase(remove_if(questions.begin(), questions.end(),
+                              [](const Question& q) { return !isObjective(q.type); }),
+                    questions.end());
     if (questions.empty()) {
         cout << "No questions found, please use obj-insert.cpp to add questions\n";
         return 1;
     }
+    if (batch) {
+        return batchMode(questions, sheets, sheetKeys, keyFiles, reportFile);
+    }
+    if (!clusterFile.empty()) keepOnePerCluster(questions, clusterFile, sampling.rng);
+    if (banks.files.size() > 1) {
+        cout << "Loaded " << questions.size() << " questions from " << banks.files.size() << " banks";
+        if (!banks.duplicates.empty()) cout << " (" << banks.duplicates.size() << " duplicates skipped)";
+        cout << "\n";
+    }
+    if (!calibrationFile.empty()) {
+        if (!query.empty()) searchQuestions(banks, questions, query);
+        if (questions.empty()) return 1;
+        adaptiveMode(questions, calibrationFile, banks.files, binaryJournal, sampling);
+        return 0;
+    }
 
     string mode;
-    cout << "Please select mode:\n1. Sequential Quiz\n2. Random Quiz\nPlease choose: ";
-    getline(cin, mode);
+    if (query.empty()) {
+        cout << "Please select mode:\n1. Sequential Quiz\n2. Random Quiz\n3. Review Due (spaced repetition)\n"
+                "4. Search\nPlease choose: ";
+        getline(cin, mode);
+        if (mode[0] == '4') {
+            cout << "Please enter keywords: ";
+            getline(cin, query);
+        }
+    }
+    if (!query.empty()) {
+        searchQuestions(banks, questions, query);
+        if (questions.empty()) return 1;
+        cout << "Please select mode:\n1. Sequential Quiz\n2. Random Quiz\n3. Review Due (spaced repetition)\nPlease choose: ";
+        getline(cin, mode);
+    }
 
-    quizMode(questions, mode[0] == '2');
+    if (mode[0] == '3') {
+        reviewMode(questions, banks.files, binaryJournal, sampling.rng);
+    } else {
+        quizMode(questions, mode[0] == '2', banks.files, binaryJournal, sampling);
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <filesystem>
+
+#include <unistd.h>
+
+#include "../Common/json.h"
+
+using namespace std;
+
+// bank-export Ļعԣ obj-insert ޸Ĺļ¼־һĹһΡһⱻɾ
+// ֻܰ޸ǵ°汾
+// ÷bank-export-test [bank-export ·]Ĭ ./bank-exportͨʱ 0
+
+string putRecord(int id, const string& text) {
+    return "#RECORD " + to_string(id) + " PUT " + to_string(text.size()) + "\n" + text + "\n";
+}
+
+string choiceText(const string& question, int correct) {
+    return "#CHOICE\n" + question + "\n#OPTIONS\nfirst\nsecond\n#CORRECT\n" + to_string(correct) + "\n#END";
+}
+
+bool readJsonFile(const filesystem::path& path, JsonValue& out) {
+    ifstream in(path, ios::binary);
+    stringstream ss;
+    ss << in.rdbuf();
+    return in && parseJson(ss.str(), out) && out.isArray();
+}
+
+int fail(const filesystem::path& dir, const string& message) {
+    cerr << "FAIL: " << message << "\n";
+    error_code ec;
+    filesystem::remove_all(dir, ec);
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    string exporter = argc > 1 ? argv[1] : "./bank-export";
+    filesystem::path dir = filesystem::temp_directory_path() / ("bank-export-test-" + to_string(getpid()));
+    error_code ec;
+    filesystem::remove_all(dir, ec);
+    filesystem::create_directories(dir / "data", ec);
+    if (ec) return fail(dir, "unable to create " + dir.string());
+
+    //  0 дɰ汾 1 дɾ 0 д°汾
+    filesystem::path bank = dir / "bank.txt";
+    {
+        ofstream out(bank, ios::binary);
+        out << putRecord(0, choiceText("old version", 1)) << putRecord(1, choiceText("deleted question", 1))
+            << "#RECORD 1 DEL\n\n" << putRecord(0, choiceText("new version", 2));
+        if (!out) return fail(dir, "unable to write " + bank.string());
+    }
+
+    string command = "\"" + exporter + "\" --objective \"" + bank.string() + "\" --subjective \"" + bank.string() +
+                     "\" --out \"" + (dir / "data").string() + "\" > /dev/null";
+    if (system(command.c_str()) != 0) return fail(dir, "bank-export failed: " + command);
+
+    JsonValue objective, subjective;
+    if (!readJsonFile(dir / "data" / "objective_questions.json", objective)) {
+        return fail(dir, "objective_questions.json is missing or invalid");
+    }
+    if (!readJsonFile(dir / "data" / "subjective_questions.json", subjective)) {
+        return fail(dir, "subjective_questions.json is missing or invalid");
+    }
+    if (objective.items.size() != 1) {
+        return fail(dir, "expected 1 objective question, got " + to_string(objective.items.size()));
+    }
+    const JsonValue& q = objective.items[0];
+    const JsonValue* question = q.find("question");
+    const JsonValue* answer = q.find("answer_index");
+    if (!question || question->str != "new version") return fail(dir, "exported question is not the latest version");
+    if (!answer || answer->number != 1) return fail(dir, "exported answer_index is not the latest version");
+    if (!subjective.items.empty()) {
+        return fail(dir, "expected no subjective questions, got " + to_string(subjective.items.size()));
+    }
+
+    filesystem::remove_all(dir, ec);
+    cout << "PASS: only the latest version of each live question was exported\n";
+    return 0;
+}
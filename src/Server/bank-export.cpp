@@ -0,0 +1,148 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <cstdio>
+
+#include "../Common/bank-set.h"
+#include "../Common/json.h"
+#include "../Common/question-bank.h"
+#include "../Common/question-json.h"
+#include "../Common/thread-pool.h"
+
+using namespace std;
+
+//  txt ⵼Ϊ Web ʹõ data/objective_questions.json  data/subjective_questions.json
+//  scripts/convert_txt_to_json.pyⰴ obj-quiz / sub-quiz ͬ﷨֧ #RECORD ¼
+// UTF-8 / GBK ⣩ⲢндͶᵼѡ qtype Ϊ multiple
+// ÷bank-export [--objective ...] [--subjective ...] [--out Ŀ¼] [--compact]
+//   Ĭűͬ͹ ../../backup/*.txt ../Subjective-Question/*.txt ../../data
+//   ֧ͨ--compact еĽոʽĬÿ 2 ոűͬ
+
+struct ExportJob {
+    string file;
+    bool objective;
+    string json;  // һεԪأ
+    size_t count = 0;
+    bool ok = false;
+};
+
+// Ȿsub-answer.txtļ¼ҲĿɵ #USER_ANSWER Ϊֹ#CORRECT_ANSWER ֮ǲο
+Question historyAsQuestion(const Question& q) {
+    size_t user = q.question.size(), correct = q.question.size();
+    for (size_t i = 0; i < q.question.size(); ++i) {
+        string_view marker = trimLineEnd(q.question[i]);
+        if (marker == "#USER_ANSWER" && user == q.question.size()) user = i;
+        if (marker == "#CORRECT_ANSWER") correct = i;
+    }
+    if (user == q.question.size()) return q;
+    Question h = q;
+    h.question.count = user;
+    if (correct < q.question.size()) h.answers = {q.question.ptr + correct + 1, q.question.size() - correct - 1};
+    return h;
+}
+
+void exportFile(ExportJob& job, int indent) {
+    //  obj-quiz ͬµ .qbk ʱֱӶȡı޸ĻɾĿֻȡÿŵ°汾
+    QuestionBank bank;
+    if (!loadBank(job.file, bank)) return;
+    string source = filesystem::path(job.file).filename().string();
+    if (detectEncoding(source) == TextEncoding::GBK) {
+        string utf8;
+        gbkToUtf8(source, utf8);
+        source = move(utf8);
+    }
+    job.json.reserve(bank.file.view().size() + bank.converted.size() + bank.questions.size() * 128);
+    JsonWriter w(job.json, indent, 1);
+    QuestionJsonScratch scratch;
+    for (const Question& q : bank.questions) {
+        if (isObjective(q.type) != job.objective || q.question.empty()) continue;
+        writeQuestionJson(w, job.objective ? q : historyAsQuestion(q), source, scratch);
+        ++job.count;
+    }
+    job.ok = true;
+}
+
+// ļ˳дΣдʱļٸ˲дһļ
+bool writeArray(const string& path, const vector<ExportJob*>& jobs, int indent) {
+    string tmp = path + ".tmp";
+    ofstream out(tmp, ios::binary);
+    if (!out) return false;
+    out << '[';
+    bool empty = true;
+    for (const ExportJob* job : jobs) {
+        if (job->json.empty()) continue;
+        if (!empty) out << ',';
+        out << job->json;
+        empty = false;
+    }
+    if (!empty && indent > 0) out << '\n';
+    out << ']';
+    out.close();
+    if (!out) return false;
+    error_code ec;
+    filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> objectivePatterns, subjectivePatterns;
+    string outDir = "../../data";
+    int indent = 2;
+    vector<string>* list = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--objective") list = &objectivePatterns;
+        else if (arg == "--subjective") list = &subjectivePatterns;
+        else if (arg == "--out" && i + 1 < argc) outDir = argv[++i];
+        else if (arg == "--compact") indent = 0;
+        else if (list && arg.compare(0, 2, "--") != 0) list->push_back(arg);
+        else {
+            cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (objectivePatterns.empty()) objectivePatterns.push_back("../../backup/*.txt");
+    if (subjectivePatterns.empty()) subjectivePatterns.push_back("../Subjective-Question/*.txt");
+
+    auto start = chrono::steady_clock::now();
+    vector<ExportJob> jobs;
+    for (const auto& f : expandBankPatterns(objectivePatterns)) jobs.push_back({f, true, "", 0, false});
+    for (const auto& f : expandBankPatterns(subjectivePatterns)) jobs.push_back({f, false, "", 0, false});
+    // ļȿʼ̵߳Ĺ
+    vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    vector<uintmax_t> sizes(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        error_code ec;
+        sizes[i] = filesystem::file_size(jobs[i].file, ec);
+    }
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+    parallelFor(order.size(), [&](size_t i) { exportFile(jobs[order[i]], indent); });
+
+    vector<ExportJob*> objective, subjective;
+    size_t counts[2] = {0, 0}, failed = 0;
+    for (auto& job : jobs) {
+        (job.objective ? objective : subjective).push_back(&job);
+        counts[job.objective ? 0 : 1] += job.count;
+        if (!job.ok) ++failed;
+    }
+    error_code ec;
+    filesystem::create_directories(outDir, ec);
+    string objectivePath = (filesystem::path(outDir) / "objective_questions.json").string();
+    string subjectivePath = (filesystem::path(outDir) / "subjective_questions.json").string();
+    if (!writeArray(objectivePath, objective, indent) || !writeArray(subjectivePath, subjective, indent)) {
+        cerr << "Unable to write " << outDir << "\n";
+        return 1;
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    printf("Exported %zu objective questions from %zu banks to %s\n", counts[0], objective.size(),
+           objectivePath.c_str());
+    printf("Exported %zu subjective questions from %zu banks to %s\n", counts[1], subjective.size(),
+           subjectivePath.c_str());
+    printf("Done in %.1f ms\n", ms);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+
+// ӿѹ⣺C Ӳÿӷ N ͳӳٷλ
+// ͬʱַ Node  C++ 棩βԺ
+// ÷load-test [-c ] [-n ÿ] [--path ·] [--body ] :˿...
+//   ָ --body ʱ POST GET
+
+struct Target {
+    string host;
+    string port;
+};
+
+struct Result {
+    string target;
+    size_t ok = 0;
+    size_t errors = 0;
+    double seconds = 0;
+    vector<double> latencies;  // 
+};
+
+int connectTo(const Target& t) {
+    addrinfo hints{}, *res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(t.host.c_str(), t.port.c_str(), &hints, &res) != 0) return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) < 0) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if (fd >= 0) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        timeval timeout{10, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    return fd;
+}
+
+// ȡһӦ Content-Length  chunked ״̬룬 -1
+int readResponse(int fd, string& buffer) {
+    size_t headerEnd;
+    char chunk[65536];
+    while ((headerEnd = buffer.find("\r\n\r\n")) == string::npos) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return -1;
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+    int status = atoi(buffer.c_str() + 9);
+    string head = buffer.substr(0, headerEnd);
+    for (auto& c : head) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    size_t bodyStart = headerEnd + 4;
+
+    if (head.find("transfer-encoding: chunked") != string::npos) {
+        size_t pos = bodyStart;
+        for (;;) {
+            size_t lineEnd;
+            while ((lineEnd = buffer.find("\r\n", pos)) == string::npos) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) return -1;
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+            size_t size = strtoul(buffer.c_str() + pos, nullptr, 16);
+            size_t need = lineEnd + 2 + size + 2;
+            while (buffer.size() < need) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) return -1;
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+            pos = need;
+            if (size == 0) break;
+        }
+        buffer.erase(0, pos);
+        return status;
+    }
+
+    size_t length = 0;
+    size_t cl = head.find("content-length:");
+    if (cl != string::npos) length = strtoul(head.c_str() + cl + 15, nullptr, 10);
+    while (buffer.size() < bodyStart + length) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return -1;
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+    buffer.erase(0, bodyStart + length);
+    return status;
+}
+
+Result run(const Target& target, int connections, int requests, const string& path, const string& body) {
+    string request = (body.empty() ? "GET " : "POST ") + path + " HTTP/1.1\r\nHost: " + target.host + ":" +
+                     target.port + "\r\nConnection: keep-alive\r\n";
+    if (!body.empty()) {
+        request += "Content-Type: application/json\r\nContent-Length: " + to_string(body.size()) + "\r\n\r\n" + body;
+    } else {
+        request += "\r\n";
+    }
+
+    Result result;
+    result.target = target.host + ":" + target.port;
+    vector<vector<double>> latencies(connections);
+    atomic<size_t> ok{0}, errors{0};
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int c = 0; c < connections; ++c) {
+        workers.emplace_back([&, c] {
+            latencies[c].reserve(requests);
+            int fd = connectTo(target);
+            string buffer;
+            for (int i = 0; i < requests; ++i) {
+                if (fd < 0) {
+                    errors += requests - i;
+                    break;
+                }
+                auto t0 = chrono::steady_clock::now();
+                int status = -1;
+                if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.size())) {
+                    status = readResponse(fd, buffer);
+                }
+                auto t1 = chrono::steady_clock::now();
+                if (status >= 200 && status < 300) {
+                    ++ok;
+                    latencies[c].push_back(chrono::duration<double, milli>(t1 - t0).count());
+                } else {
+                    ++errors;
+                }
+                if (status < 0) {  // ӶϿ
+                    close(fd);
+                    buffer.clear();
+                    fd = connectTo(target);
+                }
+            }
+            if (fd >= 0) close(fd);
+        });
+    }
+    for (auto& w : workers) w.join();
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.ok = ok;
+    result.errors = errors;
+    for (auto& l : latencies) result.latencies.insert(result.latencies.end(), l.begin(), l.end());
+    sort(result.latencies.begin(), result.latencies.end());
+    return result;
+}
+
+double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[idx];
+}
+
+int main(int argc, char* argv[]) {
+    int connections = 32;
+    int requests = 200;
+    string path = "/api/questions/objective/random?count=10";
+    string body;
+    vector<Target> targets;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-c" && i + 1 < argc) connections = max(1, atoi(argv[++i]));
+        else if (arg == "-n" && i + 1 < argc) requests = max(1, atoi(argv[++i]));
+        else if (arg == "--path" && i + 1 < argc) path = argv[++i];
+        else if (arg == "--body" && i + 1 < argc) body = argv[++i];
+        else {
+            size_t colon = arg.rfind(':');
+            if (colon == string::npos) targets.push_back({arg, "8000"});
+            else targets.push_back({arg.substr(0, colon), arg.substr(colon + 1)});
+        }
+    }
+    if (targets.empty()) {
+        cerr << "usage: load-test [-c connections] [-n requests] [--path path] [--body json] host:port...\n";
+        return 1;
+    }
+
+    cout << (body.empty() ? "GET " : "POST ") << path << ", " << connections << " connections x " << requests
+         << " requests\n";
+    printf("%-24s %10s %10s %10s %10s %8s\n", "target", "req/s", "p50 ms", "p99 ms", "max ms", "errors");
+    int rc = 0;
+    for (const auto& t : targets) {
+        Result r = run(t, connections, requests, path, body);
+        printf("%-24s %10.0f %10.3f %10.3f %10.3f %8zu\n", r.target.c_str(), r.ok / r.seconds,
+               percentile(r.latencies, 0.50), percentile(r.latencies, 0.99),
+               r.latencies.empty() ? 0.0 : r.latencies.back(), r.errors);
+        if (r.errors > 0) rc = 1;
+    }
+    return rc;
+}
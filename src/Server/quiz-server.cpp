@@ -0,0 +1,986 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <unordered_map>
+#include <filesystem>
+#include <csignal>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../Common/answer-journal.h"
+#include "../Common/bank-store.h"
+#include "../Common/json.h"
+#include "../Common/practice-session.h"
+#include "../Common/question-bank.h"
+#include "../Common/question-json.h"
+#include "../Common/question-sampler.h"
+#include "../Common/text-encoding.h"
+#include "../Common/thread-pool.h"
+
+using namespace std;
+
+//  HTTP  backend/server.js ṩͬĽӿڣⳣפڴ档
+// ʱȡ data/*.json ط׷־*.logÿһ⣩֮
+//   GET ֱӷػõ JSONظļ
+//   POST ֻ׷ӵ־ĩβд JSON ļ
+// --compact ־ϲ JSON ļ˳ϲļ Node ͬԶȡ
+// --banks  txt ṩûϰӿڣ/api/practice/...лỰһգ
+// ⱻ obj-insert ׷Ŀֲֻ滻գڽеϰʹԭĿա
+
+atomic<bool> stopping{false};
+
+// Ϣ JSON תд UTF-8ԴļΪ GBK
+const char* const kQuestionEmpty = "question \\u4e0d\\u80fd\\u4e3a\\u7a7a";
+const char* const kOptionsTooFew = "options \\u81f3\\u5c11\\u5305\\u542b\\u4e24\\u4e2a\\u9009\\u9879";
+const char* const kAnswerIndexRange = "answer_index \\u8d85\\u51fa\\u8303\\u56f4";
+const char* const kQtypeInvalid = "qtype \\u53ea\\u80fd\\u662f single\\u3001judge \\u6216 multiple";
+const char* const kAnswerIndicesInvalid =
+    "answer_indices \\u5fc5\\u987b\\u662f\\u4e0d\\u91cd\\u590d\\u4e14\\u4e0d\\u8d85\\u51fa\\u8303\\u56f4\\u7684\\u9009\\u9879\\u5e8f\\u53f7";
+const char* const kAnswerEmpty = "answer \\u4e0d\\u80fd\\u4e3a\\u7a7a";
+const char* const kContentEmpty = "content \\u4e0d\\u80fd\\u4e3a\\u7a7a";
+const char* const kKindInvalid = "kind \\u53ea\\u80fd\\u662f objective \\u6216 subjective";
+const char* const kInternalError = "\\u670d\\u52a1\\u5668\\u5185\\u90e8\\u9519\\u8bef";
+const char* const kSessionNotFound = "Session not found.";
+const char* const kNoPracticeBanks = "No practice banks loaded, start the server with --banks.";
+const char* const kNoPracticeQuestions = "No objective questions found.";
+
+string detailBody(const char* escaped) {
+    return string("{\"detail\":\"") + escaped + "\"}";
+}
+
+string trimCopy(string_view s) {
+    size_t b = s.find_first_not_of(" \t\r\n\f\v");
+    if (b == string_view::npos) return "";
+    size_t e = s.find_last_not_of(" \t\r\n\f\v");
+    return string(s.substr(b, e - b + 1));
+}
+
+// һĿ͹⣩ÿⱣ JSONд٣öд
+class QuestionStore {
+public:
+    QuestionStore(string jsonPath, string logPath) : jsonPath_(move(jsonPath)), logPath_(move(logPath)) {
+        journal_.flushBytes = 0;  // ÿ׷д
+    }
+
+    // ȡ JSON ļط׷־
+    bool load() {
+        unique_lock<shared_mutex> lock(mutex_);
+        items_.clear();
+        byType_.clear();
+        MappedFile file;
+        if (file.open(jsonPath_) && file.size() > 0) {
+            JsonValue root;
+            if (!parseJson(file.view(), root) || !root.isArray()) {
+                cerr << "Invalid JSON: " << jsonPath_ << "\n";
+                return false;
+            }
+            for (const auto& item : root.items) add(item);
+        }
+        size_t replayed = 0;
+        MappedFile log;
+        if (log.open(logPath_)) {
+            string_view text = log.view();
+            while (!text.empty()) {
+                size_t nl = text.find('\n');
+                string_view line = text.substr(0, nl);
+                text = nl == string_view::npos ? string_view() : text.substr(nl + 1);
+                JsonValue item;
+                if (line.empty()) continue;
+                if (!parseJson(line, item)) break;  // ĩβдһļ¼
+                add(item);
+                ++replayed;
+            }
+        }
+        logged_ = replayed;
+        body_.reset();
+        return journal_.open(logPath_);
+    }
+
+    // ׷⣺д־ټڴ
+    void append(const vector<JsonValue>& records) {
+        if (records.empty()) return;
+        string lines;
+        for (const auto& r : records) {
+            appendJson(lines, r);
+            lines += '\n';
+        }
+        unique_lock<shared_mutex> lock(mutex_);
+        journal_.append(lines);
+        for (const auto& r : records) add(r);
+        logged_ += records.size();
+        body_.reset();
+    }
+
+    // ȫĿ JSON 飻дһζȡʱؽֱ֮ӹ
+    shared_ptr<const string> all() {
+        {
+            shared_lock<shared_mutex> lock(mutex_);
+            if (body_) return body_;
+        }
+        unique_lock<shared_mutex> lock(mutex_);
+        if (!body_) body_ = make_shared<const string>(joinLocked(nullptr));
+        return body_;
+    }
+
+    // ȡ count ⣨ظqtype ǿʱֻڸгȡûĿʱؿմ
+    string sample(size_t count, const string& qtype) {
+        shared_lock<shared_mutex> lock(mutex_);
+        vector<uint32_t> all;
+        const vector<uint32_t>* pool = nullptr;
+        if (!qtype.empty()) {
+            auto it = byType_.find(qtype);
+            if (it == byType_.end()) return "";
+            pool = &it->second;
+        }
+        size_t n = pool ? pool->size() : items_.size();
+        if (n == 0) return "";
+        count = min(count, n);
+
+        // Floyd 㷨ȡ count ͬλãѴ˳
+        thread_local QuizRandom rng(randomSeed());
+        vector<uint32_t> picks = sampleIndices(n, count, rng);
+        if (pool) {
+            for (auto& p : picks) p = (*pool)[p];
+        }
+        return joinLocked(&picks);
+    }
+
+    // ־ϲ JSON ļдʱļ滻Ȼ־
+    bool compact() {
+        unique_lock<shared_mutex> lock(mutex_);
+        JsonValue root;
+        root.type = JsonValue::ARRAY;
+        for (const auto& item : items_) {
+            JsonValue v;
+            if (parseJson(item, v)) root.items.push_back(move(v));
+        }
+        string tmp = jsonPath_ + ".tmp";
+        {
+            ofstream out(tmp, ios::binary | ios::trunc);
+            if (!out) return false;
+            string text = toJson(root, 2);
+            out.write(text.data(), static_cast<streamsize>(text.size()));
+            if (!out) return false;
+        }
+        error_code ec;
+        filesystem::rename(tmp, jsonPath_, ec);
+        if (ec) return false;
+        journal_.close();
+        ofstream(logPath_, ios::trunc);
+        logged_ = 0;
+        return journal_.open(logPath_);
+    }
+
+    size_t size() {
+        shared_lock<shared_mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    size_t logged() {
+        shared_lock<shared_mutex> lock(mutex_);
+        return logged_;
+    }
+
+    void close() {
+        unique_lock<shared_mutex> lock(mutex_);
+        journal_.close();
+    }
+
+private:
+    void add(const JsonValue& item) {
+        const JsonValue* qtype = item.find("qtype");
+        if (qtype && qtype->isString()) byType_[qtype->str].push_back(static_cast<uint32_t>(items_.size()));
+        items_.push_back(toJson(item));
+    }
+
+    string joinLocked(const vector<uint32_t>* picks) const {
+        size_t n = picks ? picks->size() : items_.size();
+        size_t bytes = 2;
+        for (size_t i = 0; i < n; ++i) bytes += items_[picks ? (*picks)[i] : i].size() + 1;
+        string out;
+        out.reserve(bytes);
+        out += '[';
+        for (size_t i = 0; i < n; ++i) {
+            if (i > 0) out += ',';
+            out += items_[picks ? (*picks)[i] : i];
+        }
+        out += ']';
+        return out;
+    }
+
+    string jsonPath_, logPath_;
+    vector<string> items_;
+    unordered_map<string, vector<uint32_t>> byType_;
+    shared_ptr<const string> body_;
+    AnswerJournal journal_;
+    size_t logged_ = 0;
+    shared_mutex mutex_;
+};
+
+// ---------- HTTP ----------
+
+struct HttpRequest {
+    string method;
+    string path;
+    string query;
+    string body;
+    string requestHeaders;  // Access-Control-Request-Headers
+    bool keepAlive = true;
+};
+
+struct HttpResponse {
+    int status = 200;
+    string body;
+    shared_ptr<const string> shared;  // Ӧ壬⸴
+};
+
+const size_t kMaxHeaderBytes = 64 * 1024;
+const size_t kMaxBodyBytes = 16 * 1024 * 1024;
+
+bool headerIs(string_view line, string_view name) {
+    if (line.size() <= name.size() || line[name.size()] != ':') return false;
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (tolower(static_cast<unsigned char>(line[i])) != name[i]) return false;
+    }
+    return true;
+}
+
+string_view headerValue(string_view line, size_t nameSize) {
+    line.remove_prefix(nameSize + 1);
+    while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) line.remove_prefix(1);
+    while (!line.empty() && (line.back() == ' ' || line.back() == '\r')) line.remove_suffix(1);
+    return line;
+}
+
+// Ӷȡһbuffer Ѷδݣˮ
+//  0 ɹ-1 ӹرջʱ-2 ʽ
+int readRequest(int fd, string& buffer, HttpRequest& req) {
+    size_t headerEnd;
+    int idle = 0;
+    while ((headerEnd = buffer.find("\r\n\r\n")) == string::npos) {
+        if (buffer.size() > kMaxHeaderBytes) return -2;
+        char chunk[16384];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n == 0) return -1;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // ճʱÿһǷ˳ 5 
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) && buffer.empty() && !stopping && ++idle < 5) continue;
+            return -1;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+
+    string_view head(buffer.data(), headerEnd);
+    size_t lineEnd = head.find("\r\n");
+    string_view requestLine = head.substr(0, lineEnd);
+    size_t sp1 = requestLine.find(' ');
+    size_t sp2 = requestLine.rfind(' ');
+    if (sp1 == string_view::npos || sp2 <= sp1) return -2;
+    req = HttpRequest();
+    req.method = string(requestLine.substr(0, sp1));
+    string_view target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+    string_view version = requestLine.substr(sp2 + 1);
+    size_t q = target.find('?');
+    req.path = string(target.substr(0, q));
+    if (q != string_view::npos) req.query = string(target.substr(q + 1));
+    req.keepAlive = version != "HTTP/1.0";
+
+    size_t contentLength = 0;
+    size_t pos = lineEnd == string_view::npos ? head.size() : lineEnd + 2;
+    while (pos < head.size()) {
+        size_t end = head.find("\r\n", pos);
+        if (end == string_view::npos) end = head.size();
+        string_view line = head.substr(pos, end - pos);
+        if (headerIs(line, "content-length")) {
+            contentLength = strtoull(string(headerValue(line, 14)).c_str(), nullptr, 10);
+        } else if (headerIs(line, "connection")) {
+            string v(headerValue(line, 10));
+            for (auto& c : v) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+            if (v == "close") req.keepAlive = false;
+            else if (v == "keep-alive") req.keepAlive = true;
+        } else if (headerIs(line, "access-control-request-headers")) {
+            req.requestHeaders = string(headerValue(line, 30));
+        }
+        pos = end + 2;
+    }
+    if (contentLength > kMaxBodyBytes) return -2;
+
+    size_t bodyStart = headerEnd + 4;
+    while (buffer.size() - bodyStart < contentLength) {
+        char chunk[65536];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n == 0) return -1;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+    req.body = buffer.substr(bodyStart, contentLength);
+    buffer.erase(0, bodyStart + contentLength);
+    return 0;
+}
+
+bool sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 413: return "Payload Too Large";
+        default: return "Internal Server Error";
+    }
+}
+
+bool sendResponse(int fd, const HttpRequest& req, const HttpResponse& res) {
+    const string& body = res.shared ? *res.shared : res.body;
+    string head = "HTTP/1.1 " + to_string(res.status) + " " + statusText(res.status) + "\r\n";
+    head += "Access-Control-Allow-Origin: *\r\n";
+    if (req.method == "OPTIONS") {
+        head += "Access-Control-Allow-Methods: GET,HEAD,PUT,PATCH,POST,DELETE\r\n";
+        if (!req.requestHeaders.empty()) head += "Access-Control-Allow-Headers: " + req.requestHeaders + "\r\n";
+        head += "Vary: Access-Control-Request-Headers\r\n";
+    }
+    if (res.status != 204) head += "Content-Type: application/json; charset=utf-8\r\n";
+    head += "Content-Length: " + to_string(res.status == 204 ? 0 : body.size()) + "\r\n";
+    head += req.keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    if (res.status == 204 || req.method == "HEAD" || body.size() <= 4096) {
+        // СӦͷϲһη
+        if (res.status != 204 && req.method != "HEAD") head += body;
+        return sendAll(fd, head.data(), head.size());
+    }
+    return sendAll(fd, head.data(), head.size()) && sendAll(fd, body.data(), body.size());
+}
+
+// ȡѯ %XX  +
+string queryParam(const string& query, string_view name) {
+    size_t pos = 0;
+    while (pos <= query.size()) {
+        size_t amp = query.find('&', pos);
+        if (amp == string::npos) amp = query.size();
+        string_view pair(query.data() + pos, amp - pos);
+        size_t eq = pair.find('=');
+        if (pair.substr(0, eq) == name) {
+            string value;
+            string_view raw = eq == string_view::npos ? string_view() : pair.substr(eq + 1);
+            for (size_t i = 0; i < raw.size(); ++i) {
+                if (raw[i] == '+') {
+                    value += ' ';
+                } else if (raw[i] == '%' && i + 2 < raw.size() && isxdigit(raw[i + 1]) && isxdigit(raw[i + 2])) {
+                    value += static_cast<char>(stoi(string(raw.substr(i + 1, 2)), nullptr, 16));
+                    i += 2;
+                } else {
+                    value += raw[i];
+                }
+            }
+            return value;
+        }
+        pos = amp + 1;
+    }
+    return "";
+}
+
+//  Node  normalizeCount ͬ޷ʱȡ 1
+size_t normalizeCount(const string& value) {
+    char* end = nullptr;
+    long long n = strtoll(value.c_str(), &end, 10);
+    return (end == value.c_str() || n <= 0) ? 1 : static_cast<size_t>(n);
+}
+
+// ---------- ӿ ----------
+
+class QuizServer {
+public:
+    explicit QuizServer(const string& dataDir)
+        : objective_(dataDir + "/objective_questions.json", dataDir + "/objective_questions.log"),
+          subjective_(dataDir + "/subjective_questions.json", dataDir + "/subjective_questions.log") {}
+
+    bool load() { return objective_.load() && subjective_.load(); }
+
+    bool compact() { return objective_.compact() && subjective_.compact(); }
+
+    void close() {
+        if (practice_) practice_->stop();
+        objective_.close();
+        subjective_.close();
+    }
+
+    QuestionStore& objective() { return objective_; }
+    QuestionStore& subjective() { return subjective_; }
+
+    // ϰõ txt ⣬ʱϰӿڷ 404watch Ϊ true ʱļı仯
+    bool loadPractice(const vector<string>& files, bool watch) {
+        auto snapshot = loadBankSnapshot(files);
+        if (!snapshot) return false;
+        practice_ = make_unique<BankWatcher>(move(snapshot));
+        if (watch) {
+            practice_->start([](const BankSnapshot& bank, size_t added, bool reloaded) {
+                cout << (reloaded ? "Reloaded" : "Appended") << " practice banks: " << bank.objective.size()
+                     << " objective questions (+" << added << ", generation " << bank.generation << ")" << endl;
+            });
+        }
+        return true;
+    }
+
+    shared_ptr<const BankSnapshot> practiceBank() const { return practice_ ? practice_->snapshot() : nullptr; }
+
+    HttpResponse handle(const HttpRequest& req) {
+        HttpResponse res;
+        if (req.method == "OPTIONS") {
+            res.status = 204;
+            return res;
+        }
+        bool get = req.method == "GET" || req.method == "HEAD";
+        bool post = req.method == "POST";
+        const string& p = req.path;
+
+        if (get && p == "/api/health") {
+            res.body = "{\"status\":\"ok\"}";
+        } else if (get && p == "/api/questions/objective") {
+            res.shared = objective_.all();
+        } else if (get && p == "/api/questions/objective/random") {
+            randomQuestions(objective_, req, queryParam(req.query, "qtype"), "No objective questions found.", res);
+        } else if (post && p == "/api/questions/objective") {
+            createObjective(req, res);
+        } else if (get && p == "/api/questions/subjective") {
+            res.shared = subjective_.all();
+        } else if (get && p == "/api/questions/subjective/random") {
+            randomQuestions(subjective_, req, "", "No subjective questions found.", res);
+        } else if (post && p == "/api/questions/subjective") {
+            createSubjective(req, res);
+        } else if (post && p == "/api/questions/import-txt") {
+            importTxt(req, res);
+        } else if (p.compare(0, 14, "/api/practice/") == 0) {
+            practice(req, string_view(p).substr(14), res);
+        } else {
+            res.status = 404;
+            res.body = "{\"detail\":\"Not Found\"}";
+        }
+        return res;
+    }
+
+private:
+    void randomQuestions(QuestionStore& store, const HttpRequest& req, const string& qtype, const char* notFound,
+                         HttpResponse& res) {
+        res.body = store.sample(normalizeCount(queryParam(req.query, "count")), qtype);
+        if (res.body.empty()) {
+            res.status = 404;
+            res.body = detailBody(notFound);
+        }
+    }
+
+    // 岻 JSON ʱն express.json Է JSON Ĵһ
+    static JsonValue parseBody(const HttpRequest& req) {
+        JsonValue body;
+        if (!parseJson(req.body, body) || !body.isObject()) {
+            body = JsonValue();
+            body.type = JsonValue::OBJECT;
+        }
+        return body;
+    }
+
+    static JsonValue sourceOrNull(const JsonValue& body) {
+        const JsonValue* source = body.find("source");
+        // payload.source || nullմfalse0 ȶΪ null
+        if (!source || source->type == JsonValue::NUL || (source->isString() && source->str.empty()) ||
+            (source->type == JsonValue::BOOL && !source->boolean) ||
+            (source->type == JsonValue::NUMBER && source->number == 0)) {
+            return JsonValue();
+        }
+        return *source;
+    }
+
+    static const char* validateObjective(const JsonValue& body) {
+        const JsonValue* question = body.find("question");
+        if (!question || !question->isString() || trimCopy(question->str).empty()) return kQuestionEmpty;
+        const JsonValue* options = body.find("options");
+        if (!options || !options->isArray() || options->items.size() < 2) return kOptionsTooFew;
+        for (const auto& o : options->items) {
+            if (!o.isString()) return kOptionsTooFew;
+        }
+        const JsonValue* qtype = body.find("qtype");
+        bool hasQtype = qtype && !(qtype->type == JsonValue::NUL || (qtype->isString() && qtype->str.empty()) ||
+                                   (qtype->type == JsonValue::BOOL && !qtype->boolean));
+        if (hasQtype &&
+            !(qtype->isString() && (qtype->str == "single" || qtype->str == "judge" || qtype->str == "multiple"))) {
+            return kQtypeInvalid;
+        }
+        if (hasQtype && qtype->str == "multiple") {
+            // ѡ⣺answer_indices ǿգÿһǷΧڵѡҲظ
+            const JsonValue* indices = body.find("answer_indices");
+            if (!indices || !indices->isArray() || indices->items.empty()) return kAnswerIndicesInvalid;
+            vector<char> seen(options->items.size(), 0);
+            for (const auto& i : indices->items) {
+                if (!i.isInteger() || i.number < 0 || i.number >= options->items.size() || seen[size_t(i.number)]) {
+                    return kAnswerIndicesInvalid;
+                }
+                seen[size_t(i.number)] = 1;
+            }
+            return nullptr;
+        }
+        const JsonValue* answer = body.find("answer_index");
+        if (!answer || !answer->isInteger() || answer->number < 0 || answer->number >= options->items.size()) {
+            return kAnswerIndexRange;
+        }
+        return nullptr;
+    }
+
+    // ѡ answer_indices Сд
+    static JsonValue answerIndicesJson(vector<double> indices) {
+        sort(indices.begin(), indices.end());
+        JsonValue out;
+        out.type = JsonValue::ARRAY;
+        for (double i : indices) out.items.push_back(JsonValue::makeNumber(i));
+        return out;
+    }
+
+    void createObjective(const HttpRequest& req, HttpResponse& res) {
+        JsonValue body = parseBody(req);
+        if (const char* error = validateObjective(body)) {
+            res.status = 400;
+            res.body = detailBody(error);
+            return;
+        }
+        JsonValue q;
+        q.type = JsonValue::OBJECT;
+        q.set("id", JsonValue::makeString(randomUuid()));
+        q.set("question", JsonValue::makeString(trimCopy(body.find("question")->str)));
+        JsonValue options;
+        options.type = JsonValue::ARRAY;
+        for (const auto& o : body.find("options")->items) options.items.push_back(JsonValue::makeString(trimCopy(o.str)));
+        q.set("options", move(options));
+        const JsonValue* qtype = body.find("qtype");
+        bool multiple = qtype && qtype->isString() && qtype->str == "multiple";
+        JsonValue indices;
+        if (multiple) {
+            vector<double> numbers;
+            for (const auto& i : body.find("answer_indices")->items) numbers.push_back(i.number);
+            indices = answerIndicesJson(move(numbers));
+            q.set("answer_index", indices.items[0]);
+        } else {
+            q.set("answer_index", *body.find("answer_index"));
+        }
+        q.set("qtype", JsonValue::makeString(qtype && qtype->isString() && !qtype->str.empty() ? qtype->str : "single"));
+        q.set("source", sourceOrNull(body));
+        if (multiple) q.set("answer_indices", move(indices));
+        objective_.append({q});
+        res.status = 201;
+        res.body = toJson(q);
+    }
+
+    void createSubjective(const HttpRequest& req, HttpResponse& res) {
+        JsonValue body = parseBody(req);
+        const JsonValue* question = body.find("question");
+        const JsonValue* answer = body.find("answer");
+        const char* error = nullptr;
+        if (!question || !question->isString() || trimCopy(question->str).empty()) error = kQuestionEmpty;
+        else if (!answer || !answer->isString() || trimCopy(answer->str).empty()) error = kAnswerEmpty;
+        if (error) {
+            res.status = 400;
+            res.body = detailBody(error);
+            return;
+        }
+        JsonValue q;
+        q.type = JsonValue::OBJECT;
+        q.set("id", JsonValue::makeString(randomUuid()));
+        q.set("question", JsonValue::makeString(trimCopy(question->str)));
+        q.set("answer", JsonValue::makeString(trimCopy(answer->str)));
+        q.set("source", sourceOrNull(body));
+        subjective_.append({q});
+        res.status = 201;
+        res.body = toJson(q);
+    }
+
+    static string joinLines(const Span<string_view>& lines) {
+        string out;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (i > 0) out += '\n';
+            out += lines[i];
+        }
+        return out;
+    }
+
+    //  obj-quiz ͬĽϴ txt ⣺
+    // ͹⵼ж⡢ѡͶѡ⣨ѡ answer_indices Node ͬ⵼ɺͲο
+    void importTxt(const HttpRequest& req, HttpResponse& res) {
+        JsonValue body = parseBody(req);
+        const JsonValue* content = body.find("content");
+        const JsonValue* kind = body.find("kind");
+        if (!content || !content->isString() || trimCopy(content->str).empty()) {
+            res.status = 400;
+            res.body = detailBody(kContentEmpty);
+            return;
+        }
+        bool objective = kind && kind->isString() && kind->str == "objective";
+        if (!objective && !(kind && kind->isString() && kind->str == "subjective")) {
+            res.status = 400;
+            res.body = detailBody(kKindInvalid);
+            return;
+        }
+        JsonValue source = sourceOrNull(body);
+        if (source.type == JsonValue::NUL) source = JsonValue::makeString("txt-import");
+
+        // obj-insert / sub-insert ޸ĹǼ¼־Ȼطųÿŵ°汾
+        string live;
+        QuestionBank bank;
+        parseQuestions(liveBankText(content->str, live), bank);
+        vector<JsonValue> records;
+        for (const auto& bq : bank.questions) {
+            JsonValue q;
+            q.type = JsonValue::OBJECT;
+            q.set("id", JsonValue::makeString(randomUuid()));
+            if (objective) {
+                if (!isObjective(bq.type)) continue;
+                q.set("qtype", JsonValue::makeString(questionTypeInfo(bq.type).jsonName));
+                q.set("question", JsonValue::makeString(joinLines(bq.question)));
+                JsonValue options;
+                options.type = JsonValue::ARRAY;
+                for (const auto& o : bq.options) options.items.push_back(JsonValue::makeString(string(o)));
+                q.set("options", move(options));
+                q.set("answer_index", JsonValue::makeNumber(bq.correctAnswers ? lowestBit(bq.correctAnswers) : 0));
+                if (questionTypeInfo(bq.type).multipleAnswers) {
+                    vector<double> numbers;
+                    for (uint32_t m = bq.correctAnswers; m; m &= m - 1) numbers.push_back(lowestBit(m));
+                    q.set("answer_indices", answerIndicesJson(move(numbers)));
+                }
+            } else {
+                if (isObjective(bq.type)) continue;
+                q.set("question", JsonValue::makeString(joinLines(bq.question)));
+                q.set("answer", JsonValue::makeString(joinLines(bq.answers)));
+            }
+            q.set("source", source);
+            records.push_back(move(q));
+        }
+        (objective ? objective_ : subjective_).append(records);
+        res.status = 201;
+        res.body = "{\"imported\":" + to_string(records.size()) + "}";
+    }
+
+    // ---------- ûϰ ----------
+    //   POST   /api/practice/sessions              {"count":20,"seed":1,"qtype":"choice"} ʼϰ
+    //   GET    /api/practice/sessions/{id}/next    ǰ⣨ѡѰỰң
+    //   POST   /api/practice/sessions/{id}/answer  {"answer":"A,C"} شǰ
+    //   GET    /api/practice/sessions/{id}         ÷ֺʹ
+    //   DELETE /api/practice/sessions/{id}         ϰ
+    //   GET    /api/practice/stats                 ỰͻỰռõڴ
+    void practice(const HttpRequest& req, string_view rest, HttpResponse& res) {
+        bool get = req.method == "GET" || req.method == "HEAD";
+        if (!practice_) {
+            res.status = 404;
+            res.body = detailBody(kNoPracticeBanks);
+            return;
+        }
+        if (get && rest == "stats") {
+            size_t count, bytes;
+            sessions_.stats(count, bytes);
+            auto bank = practice_->snapshot();
+            res.body = "{\"sessions\":" + to_string(count) + ",\"session_bytes\":" + to_string(bytes) +
+                       ",\"questions\":" + to_string(bank->objective.size()) +
+                       ",\"generation\":" + to_string(bank->generation) + "}";
+            return;
+        }
+        if (req.method == "POST" && rest == "sessions") {
+            createSession(req, res);
+            return;
+        }
+        if (rest.compare(0, 9, "sessions/") != 0) {
+            res.status = 404;
+            res.body = "{\"detail\":\"Not Found\"}";
+            return;
+        }
+        rest.remove_prefix(9);
+        size_t slash = rest.find('/');
+        string_view action = slash == string_view::npos ? string_view() : rest.substr(slash + 1);
+        string idText(rest.substr(0, slash));
+        char* end = nullptr;
+        uint64_t id = strtoull(idText.c_str(), &end, 16);
+        bool found = false;
+        if (end != idText.c_str() && *end == '\0') {
+            if (req.method == "DELETE" && action.empty()) {
+                found = sessions_.remove(id);
+                if (found) res.status = 204;
+            } else if (get && action.empty()) {
+                found = sessions_.with(id, [&](PracticeSession& s) { res.body = sessionSummary(s); });
+            } else if (get && action == "next") {
+                found = sessions_.with(id, [&](PracticeSession& s) { res.body = currentQuestion(s); });
+            } else if (req.method == "POST" && action == "answer") {
+                JsonValue body = parseBody(req);
+                const JsonValue* answer = body.find("answer");
+                string input = answer && answer->isString() ? answer->str : "";
+                found = sessions_.with(id, [&](PracticeSession& s) { res.body = answerQuestion(s, input); });
+            } else {
+                res.status = 404;
+                res.body = "{\"detail\":\"Not Found\"}";
+                return;
+            }
+        }
+        if (!found) {
+            res.status = 404;
+            res.body = detailBody(kSessionNotFound);
+        }
+    }
+
+    //  qtypejudge/choice/multichoiceָʱޣӵǰյĿ͹г count ⣬
+    // ỰһֱʹôʱĿ
+    void createSession(const HttpRequest& req, HttpResponse& res) {
+        JsonValue body = parseBody(req);
+        const JsonValue* count = body.find("count");
+        const JsonValue* seedValue = body.find("seed");
+        const JsonValue* qtype = body.find("qtype");
+        size_t n = count && count->isInteger() && count->number > 0 ? static_cast<size_t>(count->number) : 20;
+        uint64_t seed = seedValue && seedValue->isInteger() ? static_cast<uint64_t>(seedValue->number) : randomSeed();
+
+        shared_ptr<const BankSnapshot> snapshot = practice_->snapshot();
+        const BankSnapshot& bank = *snapshot;
+        const vector<uint32_t>* pool = &bank.objective;
+        static const vector<uint32_t> none;
+        if (qtype && qtype->isString() && !qtype->str.empty()) {
+            string name = qtype->str;
+            transform(name.begin(), name.end(), name.begin(), ::toupper);
+            QuestionType type;
+            bool known = parseQuestionType(name, type) && isObjective(type);
+            pool = known ? &bank.byType[static_cast<size_t>(type)] : &none;
+        }
+        if (pool->empty()) {
+            res.status = 404;
+            res.body = detailBody(kNoPracticeQuestions);
+            return;
+        }
+        QuizRandom rng(seed);
+        vector<uint32_t> order = sampleIndices(pool->size(), n, rng);
+        for (auto& i : order) i = (*pool)[i];
+        size_t total = order.size();
+        uint64_t id = sessions_.create(move(snapshot), move(order), rng());
+
+        char idText[24];
+        snprintf(idText, sizeof(idText), "%016llx", static_cast<unsigned long long>(id));
+        res.status = 201;
+        res.body = string("{\"session\":\"") + idText + "\",\"total\":" + to_string(total) +
+                   ",\"seed\":" + to_string(seed) + "}";
+    }
+
+    // ıΪ GBKдӦǰת UTF-8
+    static void appendGbkString(string& out, string_view gbk) {
+        string utf8;
+        gbkToUtf8(gbk, utf8);
+        appendJsonString(out, utf8);
+    }
+
+    // ȷ𰸰Ựеʾ˳дĸжд T/F
+    static string displayAnswer(const Question& q, const vector<int>& order) {
+        if (q.type == QuestionType::JUDGE) return q.correctAnswers & 1u ? "T" : "F";
+        string letters;
+        for (size_t k = 0; k < order.size(); ++k) {
+            if (order[k] < 32 && (q.correctAnswers >> order[k]) & 1u) {
+                if (!letters.empty()) letters += ',';
+                letters += static_cast<char>('A' + k);
+            }
+        }
+        return letters;
+    }
+
+    static string currentQuestion(const PracticeSession& s) {
+        const Question* q = s.current();
+        if (!q) {
+            return "{\"done\":true,\"answered\":" + to_string(s.answered()) +
+                   ",\"correct\":" + to_string(s.correct()) + "}";
+        }
+        vector<int> order;
+        s.currentOptionOrder(order);
+        string out = "{\"number\":" + to_string(s.answered() + 1) + ",\"total\":" + to_string(s.total()) +
+                     ",\"qtype\":\"" + string(questionTypeName(q->type)) + "\",\"source\":";
+        appendJsonString(out, filesystem::path(s.bank().files[q->source]).filename().string());
+        out += ",\"question\":";
+        appendGbkString(out, joinLines(q->question));
+        out += ",\"options\":[";
+        for (size_t k = 0; k < order.size(); ++k) {
+            if (k > 0) out += ',';
+            appendGbkString(out, q->options[order[k]]);
+        }
+        out += "]}";
+        return out;
+    }
+
+    static string answerQuestion(PracticeSession& s, const string& input) {
+        const Question* q = s.current();
+        if (!q) return currentQuestion(s);
+        vector<int> order;
+        s.currentOptionOrder(order);
+        string answer = displayAnswer(*q, order);
+        uint32_t userMask = 0;
+        bool correct = s.answer(input, userMask);
+        return string("{\"correct\":") + (correct ? "true" : "false") + ",\"answer\":\"" + answer +
+               "\",\"score\":" + to_string(s.correct()) + ",\"answered\":" + to_string(s.answered()) +
+               ",\"remaining\":" + to_string(s.total() - s.answered()) + "}";
+    }
+
+    // ⰴԭѡ˳ɡȷ𰸺û𰸣ѡŴ 0 ʼ
+    static string sessionSummary(const PracticeSession& s) {
+        string out = "{\"total\":" + to_string(s.total()) + ",\"answered\":" + to_string(s.answered()) +
+                     ",\"correct\":" + to_string(s.correct()) + ",\"wrong\":[";
+        const auto& questions = s.bank().questions;
+        for (size_t i = 0; i < s.wrong().size(); ++i) {
+            const auto& w = s.wrong()[i];
+            const Question& q = questions[w.question];
+            if (i > 0) out += ',';
+            out += "{\"question\":";
+            appendGbkString(out, joinLines(q.question));
+            out += ",\"correct_mask\":" + to_string(q.correctAnswers) + ",\"answer_mask\":" + to_string(w.answer) + "}";
+        }
+        out += "]}";
+        return out;
+    }
+
+    QuestionStore objective_;
+    QuestionStore subjective_;
+    unique_ptr<BankWatcher> practice_;
+    SessionManager sessions_;
+};
+
+// һϵȫkeep-aliveֱԷرաгʱ˳
+void serveConnection(int fd, QuizServer& server) {
+    timeval timeout{1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    string buffer;
+    HttpRequest req;
+    for (;;) {
+        int rc = readRequest(fd, buffer, req);
+        if (rc == -1) break;
+        HttpResponse res;
+        if (rc == -2) {
+            req.keepAlive = false;
+            res.status = 400;
+            res.body = "{\"detail\":\"Bad Request\"}";
+        } else {
+            try {
+                res = server.handle(req);
+            } catch (const exception& e) {
+                cerr << e.what() << "\n";
+                res = HttpResponse();
+                res.status = 500;
+                res.body = detailBody(kInternalError);
+            }
+        }
+        if (stopping) req.keepAlive = false;
+        if (!sendResponse(fd, req, res) || !req.keepAlive) break;
+    }
+    ::close(fd);
+}
+
+void onSignal(int) { stopping = true; }
+
+int main(int argc, char* argv[]) {
+    // --port ˿ڣĬȡ PORT 8000
+    // --data Ŀ¼Ĭ ../../data src/Server ʱĲֿ data Ŀ¼
+    // --threads ӵ߳ÿ keep-alive ռһ߳
+    // --compact ׷־ϲ JSON ļ˳
+    // --banks ϰõ txt ⣨жָ֧ͨ /api/practice/ ӿ
+    // --no-watch ϰı仯Ĭ׷ӵĿԶ֮󴴽ϰ
+    int port = getenv("PORT") ? atoi(getenv("PORT")) : 8000;
+    string dataDir = "../../data";
+    unsigned threads = max(64u, defaultThreadCount() * 4);
+    bool compactOnly = false;
+    vector<string> bankPatterns;
+    bool watch = true;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) port = atoi(argv[++i]);
+        else if (arg == "--data" && i + 1 < argc) dataDir = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc) threads = static_cast<unsigned>(max(1, atoi(argv[++i])));
+        else if (arg == "--compact") compactOnly = true;
+        else if (arg == "--no-watch") watch = false;
+        else if (arg == "--banks") {
+            while (i + 1 < argc && argv[i + 1][0] != '-') bankPatterns.push_back(argv[++i]);
+        }
+    }
+
+    QuizServer server(dataDir);
+    if (!server.load()) {
+        cerr << "Unable to load question data from " << dataDir << "\n";
+        return 1;
+    }
+    if (compactOnly) {
+        size_t merged = server.objective().logged() + server.subjective().logged();
+        if (!server.compact()) {
+            cerr << "Compaction failed\n";
+            return 1;
+        }
+        cout << "Merged " << merged << " logged questions into " << dataDir << "\n";
+        return 0;
+    }
+    if (!bankPatterns.empty() && !server.loadPractice(expandBankPatterns(bankPatterns), watch)) {
+        cerr << "Unable to load practice banks\n";
+        return 1;
+    }
+
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd, 1024) < 0) {
+        perror("listen");
+        return 1;
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    cout << "Problem Drill C++ backend running on http://localhost:" << port << " (" << server.objective().size()
+         << " objective, " << server.subjective().size() << " subjective questions, " << threads << " threads)"
+         << endl;
+    if (auto bank = server.practiceBank()) {
+        cout << "Practice sessions enabled: " << bank->objective.size() << " objective questions from "
+             << bank->files.size() << " banks" << endl;
+    }
+
+    {
+        ThreadPool pool(threads);
+        while (!stopping) {
+            pollfd pfd{listenFd, POLLIN, 0};
+            if (poll(&pfd, 1, 200) <= 0) continue;
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) continue;
+            pool.submit([fd, &server] { serveConnection(fd, server); });
+        }
+        ::close(listenFd);
+    }  // ȴڴӽ
+    server.close();
+    cout << "Server stopped" << endl;
+    return 0;
+}
@@ -3,62 +3,162 @@
 #include <vector>
 #include <string>
 
+#include "../Common/bank-store.h"
+#include "../Common/console-encoding.h"
+
 using namespace std;
 
-struct Question {
+// ¼⡣Ŀͨ BankStore ׷ӵ⣬Ҳ԰Ų鿴޸ġɾ
+// ÷sub-insert [.txt] [--list | --show N | --edit N | --delete N | --compact]
+//   Ŵ 1 ʼ --list ʾͬ
+
+struct QuestionInput {  // ¼еĿдǰתı
     vector<string> question;  // 
     vector<string> answers;
 };
 
-int main() {
+// һɺͲο
+void inputQuestion(QuestionInput& q) {
+    cout << "ɣֶ֧Ун:\n";
+    string line;
+    // ȡɣн
+    while (true) {
+        getline(cin, line);
+        if (line.empty()) break;
+        q.question.push_back(line);
+    }
+
+    cout << "οҪ㣨ÿһн:\n";
+    // ȡд𰸣н
+    while (true) {
+        getline(cin, line);
+        if (line.empty()) break;
+        q.answers.push_back(line);
+    }
+}
+
+// ʽһı
+string formatQuestion(const QuestionInput& q) {
+    string text = "#SUBJECTIVE\n";
+    for (const auto& qLine : q.question) {  // 
+        text += qLine + "\n";
+    }
+    text += "#ANSWER\n";
+    for (const auto& ans : q.answers) {
+        text += ans + "\n";
+    }
+    text += "#END\n";
+    return text;
+}
+
+// Ų 1 ʼת BankStore ţЧʱ -1
+long long parseNumber(const char* arg, const BankStore& store) {
+    long long n = atoll(arg);
+    if (n < 1 || !store.contains(static_cast<uint32_t>(n - 1))) {
+        cerr << " " << arg << " \n";
+        return -1;
+    }
+    return n - 1;
+}
+
+// ɵһУбʾ
+string firstStemLine(const string& text) {
+    size_t begin = text.find('\n');
+    if (begin == string::npos) return "";
+    size_t end = text.find('\n', begin + 1);
+    string line = text.substr(begin + 1, end == string::npos ? string::npos : end - begin - 1);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return line;
+}
+
+// ĿĲ--list / --show / --edit / --delete / --compact
+int runCommand(BankStore& store, const string& command, const char* arg) {
+    string text;
+    if (command == "--list") {
+        for (uint32_t id = 0; id < store.size(); ++id) {
+            if (store.read(id, text)) cout << id + 1 << ". " << firstStemLine(text) << "\n";
+        }
+        cout << " " << store.liveCount() << " \n";
+        return 0;
+    }
+    if (command == "--compact") {
+        uint64_t dead = store.deadBytes();
+        if (!store.compact()) {
+            cerr << "ѹʧ!\n";
+            return 1;
+        }
+        cout << "ѹ " << dead << " ֽʧЧ¼\n";
+        return 0;
+    }
+    if (arg == nullptr) {
+        cerr << command << " Ҫ\n";
+        return 1;
+    }
+    long long id = parseNumber(arg, store);
+    if (id < 0 || !store.read(static_cast<uint32_t>(id), text)) return 1;
+    if (command == "--show") {
+        cout << text;
+    } else if (command == "--delete") {
+        if (!store.remove(static_cast<uint32_t>(id))) {
+            cerr << "ɾʧ!\n";
+            return 1;
+        }
+        cout << "ɾ " << id + 1 << " \n";
+    } else if (command == "--edit") {
+        cout << "ǰĿ:\n" << text << "\n";
+        QuestionInput q;
+        inputQuestion(q);
+        if (!store.put(static_cast<uint32_t>(id), formatQuestion(q))) {
+            cerr << "޸ʧ!\n";
+            return 1;
+        }
+        cout << "޸ĵ " << id + 1 << " \n";
+    } else {
+        cerr << "δ֪ " << command << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
     string filename;
-    cout << "ҪĿļ: ";
-    getline(cin, filename);
+    if (argc > 1) {
+        filename = argv[1];
+    } else {
+        cout << "ҪĿļ: ";
+        getline(cin, filename);
+    }
     if (filename.size() < 4 || filename.substr(filename.size() - 4) != ".txt") {
         filename += ".txt";
     }
-    ofstream outFile(filename, ios::app);
-    if (!outFile) {
+    BankStore store;
+    if (!store.open(filename)) {
         cerr << "޷ļд!\n";
         return 1;
     }
+    if (argc > 2) {
+        return runCommand(store, argv[2], argc > 3 ? argv[3] : nullptr);
+    }
 
     string choice;
     do {
-        Question q;
-        cout << "ɣֶ֧Ун:\n";
-        string line;
-        // ȡɣн
-        while (true) {
-            getline(cin, line);
-            if (line.empty()) break;
-            q.question.push_back(line);
-        }
+        QuestionInput q;
+        inputQuestion(q);
 
-        cout << "οҪ㣨ÿһн:\n";
-        // ȡд𰸣н
-        while (true) {
-            getline(cin, line);
-            if (line.empty()) break;
-            q.answers.push_back(line);
-        }
-
-        // дļ
-        outFile << "#SUBJECTIVE\n";
-        for (const auto& qLine : q.question) {  // д
-            outFile << qLine << "\n";
-        }
-        outFile << "#ANSWER\n";
-        for (const auto& ans : q.answers) {
-            outFile << ans << "\n";
+        // ׷ӵ
+        long long id = store.append(formatQuestion(q));
+        if (id < 0) {
+            cerr << "дʧ!\n";
+            return 1;
         }
-        outFile << "#END\n\n";
+        cout << "ѱΪ " << id + 1 << " \n";
 
         cout << "ǷĿ(y/[n]): ";
         getline(cin, choice);
     } while (choice[0] == 'y' || choice[0] == 'Y');
 
-    outFile.close();
+    store.close();
     cout << "Ŀѱ浽 " << filename << "\n";
     return 0;
-}
\ No newline at end of file
+}
@@ -6,151 +6,413 @@
 #include <algorithm>
 #include <ctime>
 #include <chrono>
-#include <random>
+#include <functional>
+#include <iomanip>
+#include <cmath>
+#include <unordered_map>
+
+#include "../Common/answer-journal.h"
+#include "../Common/answer-similarity.h"
+#include "../Common/compiled-bank.h"
+#include "../Common/console-encoding.h"
+#include "../Common/dedup-index.h"
+#include "../Common/lazy-bank.h"
+#include "../Common/question-sampler.h"
+#include "../Common/review-scheduler.h"
+#include "../Common/search-index.h"
+#include "../Common/session-telemetry.h"
+#include "../Common/thread-pool.h"
 
 using namespace std;
 
-struct Question {
-    vector<string> question;  // Ϊvector洢
-    vector<string> answers;
-};
+// д𰸵¼binary Ϊ true ʱдյĶƼ¼ûı
+// remembered Ϊֻ¼ڶƼ¼
+void writeAnswerToFile(AnswerJournal& journal, const Question& q, const vector<string>& userAnswers,
+                       bool remembered, bool binary) {
+    string answers;
+    for (size_t idx = 0; idx < userAnswers.size(); ++idx) {
+        answers += userAnswers[idx];  // ţԭʼʽ
+        answers += "\n";
+    }
 
-vector<Question> loadQuestions(const string& filename) {
-    vector<Question> questions;
-    ifstream file(filename);
-    if (!file) {
-        cerr << "Unable to open file: " << filename << endl;
-        return questions;
+    if (binary) {
+        JournalEntry entry{};
+        entry.fingerprint = questionFingerprint(q);
+        entry.time = static_cast<int64_t>(time(nullptr));
+        entry.type = static_cast<uint8_t>(q.type);
+        entry.correct = remembered;
+        journal.append(entry, answers);
+        return;
     }
 
-    string line;
-    Question q;
-    bool inQuestion = false;  // ǣǷڶȡ
-    bool inAnswers = false;
-
-    while (getline(file, line)) {
-        if (line == "#SUBJECTIVE") {
-            if (!q.question.empty()) questions.push_back(q); // һ
-            q = {};
-            inQuestion = true;  // ʼȡ
-            inAnswers = false;
-        } else if (line == "#ANSWER") {
-            inQuestion = false; // ȡ
-            inAnswers = true;   // ʼȡ
-        } else if (line == "#END") {
-            questions.push_back(q);
-            q = {};
-            inQuestion = false;
-            inAnswers = false;
-        } else if (inQuestion && !line.empty()) {
-            q.question.push_back(line);  // 
-        } else if (inAnswers && !line.empty()) {
-            q.answers.push_back(line);
+    string record = "#SUBJECTIVE\n";
+    for (const auto& line : q.question) {  // д
+        record += line;
+        record += "\n";
+    }
+    record += "#USER_ANSWER\n";
+    record += answers;
+    record += "#CORRECT_ANSWER\n";
+    for (const auto& ans : q.answers) {
+        record += ans;
+        record += "\n";
+    }
+    record += "#END\n\n";
+
+    journal.append(record);
+}
+
+// һⲢʾο𰸺Զ֣ûȷǷҪ㣻д¼
+bool askQuestion(const Question& q, size_t number, AnswerJournal& journal, bool binaryJournal) {
+    SessionTelemetry& tel = telemetry();
+    uint64_t fingerprint = tel.enabled() ? questionFingerprint(q) : 0;
+    uint32_t id = static_cast<uint32_t>(number);
+    uint64_t shownAt = tel.now();
+    cout << "\nQuestion " << number << ":\n";
+    cout << "[Subjective Question]\n";
+
+    int code_line = 0;
+    for (size_t j = 0; j < q.question.size(); ++j) {
+        // ⵽ǰ4ոɾ4ո񣬲϶Ϊ
+        if (q.question[j].size() >= 4 && q.question[j].substr(0,4) == "    ") {
+            printf("%2d -| ", ++code_line);
+            cout << q.question[j].substr(4) << "\n";
+        } else {
+            cout << q.question[j] << "\n";
         }
     }
+    
+    cout << "\nPlease enter the main points of your response (one per line, end with a blank line):\n";
+    vector<string> userAnswers;
+    string line;
+    uint64_t promptAt = tel.now();
+    tel.record(TelemetryPhase::RENDER, shownAt, promptAt, id, fingerprint);
+    for (int cnt = 1;; ++cnt) {
+        cout << cnt << " - ";
+        getline(cin, line);
+        if (line.empty()) break;  // н
+        userAnswers.push_back(line);
+    }
+    uint64_t answeredAt = tel.now();
 
-    if (!q.question.empty()) questions.push_back(q); // һ
-    file.close();
-    return questions;
+    // ʾû
+    cout << "\nYour Answer:\n";
+    for (const auto& ans : userAnswers) {
+        cout << ans << "\n";
+    }
+
+    // ʾο𰸣ԶΪѾҪͶӦĴ
+    AnswerScorer scorer(q.answers);
+    AnswerScore result = scorer.score(userAnswers);
+    cout << "\nReference Answer:\n";
+    for (size_t j = 0; j < q.answers.size(); ++j) {
+        const PointScore& point = result.points[j];
+        bool covered = point.similarity >= kPointCovered;
+        cout << (covered ? "[+] " : "[ ] ") << q.answers[j];
+        if (covered) cout << "  (line " << point.userLine + 1 << ", " << lround(point.similarity * 100) << "%)";
+        cout << "\n";
+    }
+    bool suggested = result.score >= kPointCovered;
+    cout << "\nAuto score: " << lround(result.score * 100) << "% (" << result.covered << "/" << scorer.points()
+         << " points)\n";
+
+    // ֱӻسʱԶֵĽ
+    cout << "Did you cover the main points? (y/n, Enter = " << (suggested ? "y" : "n") << "): ";
+    string rating;
+    getline(cin, rating);
+    bool remembered = rating.empty() ? suggested : (rating[0] == 'y' || rating[0] == 'Y');
+    // зʾο𰸵 y/n
+    uint64_t ratedAt = tel.now();
+    tel.record(TelemetryPhase::ANSWER, promptAt, answeredAt, id, fingerprint, remembered);
+    tel.record(TelemetryPhase::GRADE, answeredAt, ratedAt, id, fingerprint);
+
+    // дļ
+    writeAnswerToFile(journal, q, userAnswers, remembered, binaryJournal);
+    tel.record(TelemetryPhase::JOURNAL, ratedAt, tel.now(), id, fingerprint);
+    return remembered;
 }
 
-void writeAnswerToFile(const Question& q, const vector<string>& userAnswers) {
-    ofstream answerFile("sub-answer.txt", ios::app);
-    if (!answerFile) {
-        cerr << "Unable to open sub-answer.txt\n";
-        return;
+// ǰֹ¸ı¼sub-answer.txtеÿ¼֡
+// οͬļ¼һ AnswerScorer¼̳߳ϲ
+int rescoreHistory(const string& path) {
+    auto start = chrono::steady_clock::now();
+    MappedFile file;
+    if (!file.open(path)) {
+        cerr << "Unable to read " << path << "\n";
+        return 1;
     }
 
-    answerFile << "#SUBJECTIVE\n";
-    for (const auto& line : q.question) {  // д
-        answerFile << line << "\n";
+    struct Record {
+        string_view title;  // ɵһ
+        vector<string_view> user, reference;
+        size_t scorer = 0;
+        AnswerScore result;
+    };
+    vector<Record> records;
+    enum State { NONE, IN_QUESTION, IN_USER, IN_CORRECT } state = NONE;
+    string_view text = file.view();
+    while (!text.empty()) {
+        size_t nl = text.find('\n');
+        string_view line = text.substr(0, nl);
+        text = nl == string_view::npos ? string_view() : text.substr(nl + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        string_view marker = trimLineEnd(line);
+        if (marker == "#SUBJECTIVE") {
+            records.emplace_back();
+            state = IN_QUESTION;
+        } else if (isQuestionMarker(marker) || marker == "#END") {
+            state = NONE;
+        } else if (marker == "#USER_ANSWER" && state != NONE) {
+            state = IN_USER;
+        } else if (marker == "#CORRECT_ANSWER" && state != NONE) {
+            state = IN_CORRECT;
+        } else if (!line.empty() && state != NONE) {
+            Record& r = records.back();
+            if (state == IN_QUESTION && r.title.empty()) r.title = line;
+            else if (state == IN_USER) r.user.push_back(line);
+            else if (state == IN_CORRECT) r.reference.push_back(line);
+        }
     }
-    answerFile << "#USER_ANSWER\n";
-    for (size_t idx = 0; idx < userAnswers.size(); ++idx) {
-        answerFile << userAnswers[idx] << "\n";  // ţԭʼʽ
+
+    // οͬļ¼ֻԤһ
+    unordered_map<string, size_t> scorerOf;
+    vector<size_t> firstRecord;
+    for (size_t i = 0; i < records.size(); ++i) {
+        string key;
+        for (string_view line : records[i].reference) {
+            key += line;
+            key += '\n';
+        }
+        auto it = scorerOf.emplace(move(key), firstRecord.size()).first;
+        if (it->second == firstRecord.size()) firstRecord.push_back(i);
+        records[i].scorer = it->second;
     }
-    answerFile << "#CORRECT_ANSWER\n";
-    for (const auto& ans : q.answers) {
-        answerFile << ans << "\n";
+    vector<AnswerScorer> scorers(firstRecord.size());
+    parallelFor(scorers.size(), [&](size_t i) { scorers[i] = AnswerScorer(records[firstRecord[i]].reference); });
+    parallelFor(records.size(), [&](size_t i) { records[i].result = scorers[records[i].scorer].score(records[i].user); });
+    double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    size_t covered = 0, points = 0;
+    double total = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        const Record& r = records[i];
+        size_t n = scorers[r.scorer].points();
+        covered += r.result.covered;
+        points += n;
+        total += r.result.score;
+        char row[64];
+        snprintf(row, sizeof(row), "%6zu %4ld%% %3zu/%-3zu ", i + 1, lround(r.result.score * 100), r.result.covered, n);
+        cout << row << r.title << "\n";
+    }
+    cout << fixed << setprecision(1) << "\nRescored " << records.size() << " records (" << scorers.size()
+         << " distinct reference answers) in " << elapsed << " ms: mean score "
+         << (records.empty() ? 0.0 : total * 100 / records.size()) << "%, points covered " << covered << "/" << points
+         << "\n";
+    cout.unsetf(ios::fixed);
+    return 0;
+}
+
+// λỰÿʱλ 90 λ
+void printAnswerTimes() {
+    const LatencyHistogram& h = telemetry().histogram(TelemetryPhase::ANSWER);
+    if (h.count() == 0) return;
+    cout << fixed << setprecision(1) << "\ntime per question: median " << h.percentile(0.5) / 1e9 << " s, p90 "
+         << h.percentile(0.9) / 1e9 << " s, total " << h.sum() / 1e9 << " s\n";
+    cout.unsetf(ios::fixed);
+}
+
+// ѭȡ 0..total-1 ⣬questionAt  nullptr Ŀ limit 
+void runQuiz(size_t total, size_t limit, const function<const Question*(size_t)>& questionAt, bool binaryJournal) {
+    // Ựֻһδ¼
+    string journalPath = binaryJournal ? "sub-answer.qjl" : "sub-answer.txt";
+    AnswerJournal journal;
+    if (!journal.open(journalPath)) {
+        cerr << "Unable to open " << journalPath << "\n";
     }
-    answerFile << "#END\n\n";
 
-    answerFile.close();
+    size_t asked = 0;
+    for (size_t i = 0; i < total && asked < limit; ++i) {
+        const Question* q = questionAt(i);
+        if (q == nullptr) continue;
+        askQuestion(*q, ++asked, journal, binaryJournal);
+    }
+
+    journal.close();
+    printAnswerTimes();
+    cout << "\nquiz over, and your answers are saved to " << journalPath << "\n";
+    cout << "press [ENTER] to exit...";
+    getchar();
 }
 
-void quizMode(vector<Question>& questions, bool randomOrder) {
+// ˳⣬ȡ count ⣨count Ϊ 0 ʾȫֻţƶĿ
+void quizMode(const vector<Question>& questions, bool randomOrder, size_t count, QuizRandom& rng,
+              bool binaryJournal) {
+    count = count ? min(count, questions.size()) : questions.size();
+    vector<uint32_t> order;
     if (randomOrder) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        default_random_engine rng(rand());
-        shuffle(questions.begin(), questions.end(), rng);
-    }
-
-    for (size_t i = 0; i < questions.size(); ++i) {
-        const auto& q = questions[i];
-        cout << "\nQuestion " << i + 1 << ":\n";
-        cout << "[Subjective Question]\n";
-
-        int code_line = 0;
-        for (size_t j = 0; j < q.question.size(); ++j) {
-            // ⵽ǰ4ոɾ4ո񣬲϶Ϊ
-            if (q.question[j].size() >= 4 && q.question[j].substr(0,4) == "    ") {
-                printf("%2d -| ", ++code_line);
-                cout << q.question[j].substr(4) << "\n";
-            } else {
-                cout << q.question[j] << "\n";
-            }
-        }
-        
-        cout << "\nPlease enter the main points of your response (one per line, end with a blank line):\n";
-        vector<string> userAnswers;
-        string line;
-        for (int cnt = 1;; ++cnt) {
-            cout << cnt << " - ";
-            getline(cin, line);
-            if (line.empty()) break;  // н
-            userAnswers.push_back(line);
-        }
+        order = sampleIndices(questions.size(), count, rng);
+    } else {
+        order.resize(count);
+        for (size_t i = 0; i < count; ++i) order[i] = static_cast<uint32_t>(i);
+    }
+    runQuiz(order.size(), order.size(), [&](size_t i) { return &questions[order[i]]; }, binaryJournal);
+}
 
-        // ʾû
-        cout << "\nYour Answer:\n";
-        for (const auto& ans : userAnswers) {
-            cout << ans << "\n";
-        }
+// صĴģʽ--lazy˳ţĳʱŽ͹
+void lazyQuizMode(LazyBank& bank, bool randomOrder, size_t count, QuizRandom& rng, bool binaryJournal) {
+    IndexPermutation permutation(bank.size(), rng);
+    // runQuiz  0, 1, 2... ˳ȡ⣬ʱȡеһ
+    runQuiz(bank.size(), count ? count : bank.size(), [&](size_t i) {
+        uint64_t start = telemetry().now();
+        const Question* q = bank.get(randomOrder ? permutation.next() : i);
+        telemetry().record(TelemetryPhase::PARSE, start, telemetry().now());
+        return q && !isObjective(q->type) ? q : nullptr;
+    }, binaryJournal);
+}
 
-        // ʾο
-        cout << "\nReference Answer:\n";
-        for (const auto& ans : q.answers) {
-            cout << ans << "\n";
-        }
+// ϰģʽظSM-2ȳѵڵ⣬ٳ 20 δϰ⣬ûҪʮӺٴγ
+// ϰȱ sub-review.qrs״ʹʱеĴ¼ʷ
+void reviewMode(const vector<Question>& questions, bool binaryJournal) {
+    const string storePath = "sub-review.qrs";
+    ReviewStore store;
+    int64_t now = static_cast<int64_t>(time(nullptr));
+    if (!store.load(storePath)) {
+        size_t imported = importTextHistory("sub-answer.txt", store, now) +
+                          importJournalHistory("sub-answer.qjl", store);
+        if (imported > 0) cout << "Imported " << imported << " records from previous answer logs.\n";
+    }
 
-        // дļ
-        writeAnswerToFile(q, userAnswers);
+    vector<uint64_t> fingerprints(questions.size());
+    for (size_t i = 0; i < questions.size(); ++i) fingerprints[i] = questionFingerprint(questions[i]);
+    DueQueue queue(store, fingerprints);
+    if (queue.dueCount(now) + queue.newCount() == 0) {
+        cout << "\nNo questions are due for review.\n";
+        return;
+    }
+
+    string journalPath = binaryJournal ? "sub-answer.qjl" : "sub-answer.txt";
+    AnswerJournal journal;
+    if (!journal.open(journalPath)) {
+        cerr << "Unable to open " << journalPath << "\n";
+    }
+
+    size_t asked = 0;
+    for (long long idx; (idx = queue.popDue(now)) >= 0; now = static_cast<int64_t>(time(nullptr))) {
+        bool remembered = askQuestion(questions[idx], ++asked, journal, binaryJournal);
+        const ReviewState& s = store.review(fingerprints[idx], remembered ? 4 : 1, now);
+        queue.push(idx, s.due);
+        if (remembered) cout << "Next review in " << s.interval << " day(s).\n";
     }
 
-    cout << "\nquiz over, and your answers are saved to sub-answer.txt\n";
+    journal.close();
+    printAnswerTimes();
+    if (!store.save(storePath)) {
+        cerr << "Unable to save " << storePath << "\n";
+    } else {
+        cout << "\nreview over, and your progress is saved to " << storePath << "\n";
+    }
     cout << "press [ENTER] to exit...";
     getchar();
 }
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    ConsoleEncoding console;  // UTF-8 նԶתʾ
+    // --binary-journal¼ʹöƸʽ
+    // --search ؼʣֻϰؼʵĿ
+    // --lazyأֻ¼ĿλãŽ⣨ֻ֧˳/⣩
+    // --count ֻ N ⣬ģʽ´гȡ--seed ӣ̶ӣ
+    // --no-telemetry¼λỰļʱ־sub-telemetry.qtl
+    // --rescore [¼ļ]ԶֹеĴ¼Ĭ sub-answer.txt˳
+    bool binaryJournal = false, lazy = false, seeded = false, tracing = true;
+    size_t count = 0;
+    uint64_t seed = 0;
+    string query;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--binary-journal") {
+            binaryJournal = true;
+        } else if (arg == "--count" && i + 1 < argc) {
+            count = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+            seeded = true;
+        } else if (arg == "--lazy") {
+            lazy = true;
+        } else if (arg == "--no-telemetry") {
+            tracing = false;
+        } else if (arg == "--rescore") {
+            bool hasPath = i + 1 < argc && argv[i + 1][0] != '-';
+            return rescoreHistory(hasPath ? argv[i + 1] : "sub-answer.txt");
+        } else if (arg == "--search" && i + 1 < argc) {
+            query = argv[++i];
+            if (utf8Terminal()) utf8ToGbk(argv[i], query);  // вն˱ͬ
+        }
+    }
+    if (!seeded) seed = randomSeed();
+    QuizRandom rng(seed);
+    if (tracing) telemetry().open("sub-telemetry.qtl", 1);
+
     string filename;
     cout << "Please enter the question bank filename: ";
     getline(cin, filename);
     if (filename.size() < 4 || filename.substr(filename.size() - 4) != ".txt") {
         filename += ".txt";
     }
-    vector<Question> questions = loadQuestions(filename);
-    
+    if (lazy) {
+        if (!query.empty()) {
+            cerr << "--lazy cannot be combined with --search\n";
+            return 1;
+        }
+        auto start = chrono::steady_clock::now();
+        uint64_t loadStart = telemetry().now();
+        LazyBank lazyBank;
+        if (!lazyBank.open(filename)) return 1;
+        telemetry().record(TelemetryPhase::LOAD, loadStart, telemetry().now());
+        cout << "Indexed " << lazyBank.size() << " questions in " << fixed << setprecision(2)
+             << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms\n";
+        cout.unsetf(ios::fixed);
+        string mode;
+        cout << "Please select quiz mode:\n1. Sequential Quiz\n2. Random Quiz\nPlease choose: ";
+        getline(cin, mode);
+        if (mode[0] == '2') cout << "Random seed: " << seed << "\n";
+        lazyQuizMode(lazyBank, mode[0] == '2', count, rng, binaryJournal);
+        return 0;
+    }
+
+    QuestionBank bank;
+    uint64_t loadStart = telemetry().now();
+    loadBank(filename, bank);
+    telemetry().record(TelemetryPhase::LOAD, loadStart, telemetry().now());
+    vector<Question>& questions = bank.questions;
+    if (!query.empty()) {
+        // еĿе±꣬Ȱɸѡ
+        SearchIndex index;
+        loadSearchIndex(filename, bank, index);
+        vector<Question> matched;
+        for (uint32_t idx : index.search(query)) matched.push_back(questions[idx]);
+        questions.swap(matched);
+        cout << "Search \"" << query << "\": " << questions.size() << " matching questions\n";
+    }
+    // ֻ
+    questions.erase(remove_if(questions.begin(), questions.end(),
+                              [](const Question& q) { return isObjective(q.type); }),
+                    questions.end());
+
     if (questions.empty()) {
         cout << "No questions found, please use sub-insert.cpp to add questions\n";
         return 1;
     }
 
     string mode;
-    cout << "Please select quiz mode:\n1. Sequential Quiz\n2. Random Quiz\nPlease choose: ";
+    cout << "Please select quiz mode:\n1. Sequential Quiz\n2. Random Quiz\n3. Review Due (spaced repetition)\nPlease choose: ";
     getline(cin, mode);
 
-    quizMode(questions, mode[0] == '2');
+    if (mode[0] == '3') {
+        reviewMode(questions, binaryJournal);
+    } else {
+        if (mode[0] == '2') cout << "Random seed: " << seed << "\n";
+        quizMode(questions, mode[0] == '2', count, rng, binaryJournal);
+    }
     return 0;
 }
\ No newline at end of file
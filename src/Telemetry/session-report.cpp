@@ -0,0 +1,121 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdio>
+
+#include "../Common/session-telemetry.h"
+
+using namespace std;
+
+// Ự־ܣȡ obj-quiz / sub-quiz д .qtl Ự־ǶļǧỰ
+// ׶κʱķλԼÿỰʱȷʷֲ
+// ÷session-report [־.qtl...] [--csv .csv]
+//   ָ־ʱȡǰĿ¼ obj-telemetry.qtl  sub-telemetry.qtl
+//   --csvȫ¼Ϊ CSVÿһ¼
+
+struct SessionSummary {
+    uint8_t program = 0;
+    uint32_t questions = 0;
+    uint32_t correct = 0;
+    uint32_t dropped = 0;
+    uint64_t endNs = 0;
+};
+
+// ĵ p λȣ
+double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    return sorted[static_cast<size_t>(p * (sorted.size() - 1) + 0.5)];
+}
+
+void printRow(const char* name, vector<double>& values, double scale) {
+    if (values.empty()) return;
+    sort(values.begin(), values.end());
+    double sum = 0;
+    for (double v : values) sum += v;
+    printf("%-22s %10zu %12.1f %12.1f %12.1f %12.1f %12.1f\n", name, values.size(), sum / values.size() / scale,
+           percentile(values, 0.5) / scale, percentile(values, 0.9) / scale, percentile(values, 0.99) / scale,
+           values.back() / scale);
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> files;
+    string csvFile;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--csv" && i + 1 < argc) csvFile = argv[++i];
+        else files.push_back(arg);
+    }
+    if (files.empty()) files = {"obj-telemetry.qtl", "sub-telemetry.qtl"};
+
+    ofstream csv;
+    if (!csvFile.empty()) {
+        csv.open(csvFile, ios::binary);
+        if (!csv) {
+            cerr << "Unable to write " << csvFile << "\n";
+            return 1;
+        }
+        csv << "session,program,question,phase,start_ms,duration_us,fingerprint,result\n";
+    }
+
+    const size_t phases = static_cast<size_t>(TelemetryPhase::COUNT);
+    vector<vector<double>> durations(phases);  // 
+    unordered_map<uint64_t, SessionSummary> sessions;
+    size_t chunks = 0, events = 0;
+    for (const auto& file : files) {
+        size_t n = readTelemetryLog(file, [&](const TelemetryChunkHeader& h, const TelemetryEvent* e, size_t count) {
+            // Ựǿʼʱ䣬ͬʱʼĻỰ
+            SessionSummary& s = sessions[h.sessionId * 2 + h.program];
+            s.program = h.program;
+            s.dropped = max(s.dropped, h.dropped);
+            for (size_t i = 0; i < count; ++i) {
+                if (e[i].phase >= phases) continue;
+                durations[e[i].phase].push_back(static_cast<double>(e[i].durationNs));
+                s.endNs = max(s.endNs, e[i].startNs + e[i].durationNs);
+                if (e[i].phase == static_cast<uint8_t>(TelemetryPhase::ANSWER)) {
+                    ++s.questions;
+                    s.correct += e[i].result;
+                }
+                if (csv.is_open()) {
+                    char line[192];
+                    snprintf(line, sizeof(line), "%llu,%s,%u,%s,%.3f,%.1f,%016llx,%u\n",
+                             static_cast<unsigned long long>(h.sessionId), kTelemetryProgramNames[h.program & 1],
+                             e[i].question, kTelemetryPhaseNames[e[i].phase], e[i].startNs / 1e6,
+                             e[i].durationNs / 1e3, static_cast<unsigned long long>(e[i].fingerprint), e[i].result);
+                    csv << line;
+                }
+            }
+            events += count;
+        });
+        if (n == 0) cerr << "No telemetry in " << file << "\n";
+        chunks += n;
+    }
+    if (sessions.empty()) return 1;
+
+    size_t questions = 0, correct = 0, dropped = 0, perProgram[2] = {0, 0};
+    vector<double> sessionQuestions, sessionMinutes, sessionAccuracy;
+    for (const auto& [id, s] : sessions) {
+        questions += s.questions;
+        correct += s.correct;
+        dropped += s.dropped;
+        ++perProgram[s.program & 1];
+        sessionMinutes.push_back(s.endNs / 60e9);
+        sessionQuestions.push_back(s.questions);
+        if (s.questions > 0) sessionAccuracy.push_back(s.correct * 100.0 / s.questions);
+    }
+    printf("sessions: %zu (obj-quiz %zu, sub-quiz %zu), events: %zu in %zu chunks, dropped: %zu\n",
+           sessions.size(), perProgram[0], perProgram[1], events, chunks, dropped);
+    printf("questions answered: %zu, correct: %zu (%.1f%%)\n\n", questions, correct,
+           questions ? correct * 100.0 / questions : 0.0);
+
+    printf("%-22s %10s %12s %12s %12s %12s %12s\n", "phase (us)", "count", "mean", "p50", "p90", "p99", "max");
+    for (size_t p = 0; p < phases; ++p) printRow(kTelemetryPhaseNames[p], durations[p], 1e3);
+
+    printf("\n%-22s %10s %12s %12s %12s %12s %12s\n", "per session", "count", "mean", "p50", "p90", "p99", "max");
+    printRow("questions", sessionQuestions, 1);
+    printRow("duration (min)", sessionMinutes, 1);
+    printRow("accuracy (%)", sessionAccuracy, 1);
+    return 0;
+}